@@ -4,14 +4,10 @@
 
 
 void setup() {
-    // Initialize serial port
+    // Initialize serial port. No waiting for a monitor: the boot trace
+    // keeps the startup log and is printed later on request ("boot").
     Serial.begin(115200);
-    
-    // Wait up to 5 seconds for serial monitor connection
-    uint32_t start_time = millis();
-    while (!Serial && (millis() - start_time) < 5000) {
-        delay(10);
-    }
+    BootTrace::getInstance().mark("setup");
     
     Serial.println("\n\n######################################");
     Serial.println("[System] FIRMWARE BOOT OK");
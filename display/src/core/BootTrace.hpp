@@ -0,0 +1,84 @@
+#ifndef BOOT_TRACE_HPP
+#define BOOT_TRACE_HPP
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include "Config.hpp"
+
+/**
+ * @brief Timestamped boot stages, kept in RAM so they can be read back later
+ *
+ * Stages are marked from both cores (UI on the loop task, radio on its own
+ * task). Send "boot" over Serial at any time to print the trace.
+ */
+class BootTrace {
+public:
+    static BootTrace& getInstance() {
+        static BootTrace instance;
+        return instance;
+    }
+
+    // stage must be a string literal (only the pointer is stored)
+    void mark(const char* stage) {
+        uint32_t us = (uint32_t)esp_timer_get_time();
+        portENTER_CRITICAL(&lock);
+        if (count < BOOT_TRACE_MAX_STAGES) {
+            entries[count].stage = stage;
+            entries[count].us = us;
+            entries[count].core = (uint8_t)xPortGetCoreID();
+            count++;
+        }
+        portEXIT_CRITICAL(&lock);
+    }
+
+    uint32_t elapsedMs() const { return (uint32_t)(esp_timer_get_time() / 1000); }
+
+    void dump() {
+        Entry copy[BOOT_TRACE_MAX_STAGES];
+        portENTER_CRITICAL(&lock);
+        int n = count;
+        memcpy(copy, entries, n * sizeof(Entry));
+        portEXIT_CRITICAL(&lock);
+
+        printf("[Boot] --- trace (%d stages) ---\n", n);
+        uint32_t prev = 0;
+        for (int i = 0; i < n; i++) {
+            printf("[Boot] %8.1f ms  +%7.1f ms  core %d  %s\n",
+                   copy[i].us / 1000.0f, (copy[i].us - prev) / 1000.0f, copy[i].core, copy[i].stage);
+            prev = copy[i].us;
+        }
+    }
+
+    // Call from the loop: answers "boot" lines on Serial
+    void pollSerial() {
+        while (Serial.available()) {
+            char c = (char)Serial.read();
+            if (c == '\r' || c == '\n') {
+                cmd[cmdLen] = '\0';
+                if (strcmp(cmd, "boot") == 0) dump();
+                cmdLen = 0;
+            } else if (cmdLen < (int)sizeof(cmd) - 1) {
+                cmd[cmdLen++] = c;
+            }
+        }
+    }
+
+private:
+    BootTrace() {}
+
+    struct Entry {
+        const char* stage;
+        uint32_t us;
+        uint8_t core;
+    };
+
+    Entry entries[BOOT_TRACE_MAX_STAGES];
+    int count = 0;
+    portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+
+    char cmd[16];
+    int cmdLen = 0;
+};
+
+#endif // BOOT_TRACE_HPP
@@ -0,0 +1,103 @@
+#ifndef CATALOG_CACHE_HPP
+#define CATALOG_CACHE_HPP
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <vector>
+#include "remote_protocol.hpp"
+
+/**
+ * @brief Last confirmed controller catalogue kept in NVS
+ *
+ * Recipes are stored as the RecipeSyncData records they arrived in, pumps as
+ * PumpSyncData, each behind a small header with the protocol hash so a
+ * truncated or stale blob is rejected instead of shown.
+ */
+class CatalogCache {
+public:
+    static bool loadRecipes(std::vector<RecipeSyncData>& out, uint32_t& hash) {
+        Preferences prefs;
+        if (!prefs.begin(NVS_NAMESPACE, true)) return false;
+
+        bool ok = false;
+        size_t len = prefs.getBytesLength(KEY_RECIPES);
+        if (len >= sizeof(Header) && ((len - sizeof(Header)) % sizeof(RecipeSyncData)) == 0) {
+            std::vector<uint8_t> blob(len);
+            prefs.getBytes(KEY_RECIPES, blob.data(), len);
+
+            Header h;
+            memcpy(&h, blob.data(), sizeof(h));
+            size_t count = (len - sizeof(Header)) / sizeof(RecipeSyncData);
+            if (h.magic == MAGIC && h.format == FORMAT && h.count == count) {
+                out.resize(count);
+                memcpy(out.data(), blob.data() + sizeof(Header), count * sizeof(RecipeSyncData));
+                ok = (remote_recipes_hash(out.data(), count) == h.hash);
+                hash = h.hash;
+            }
+        }
+        prefs.end();
+        if (!ok) out.clear();
+        return ok;
+    }
+
+    static bool saveRecipes(const std::vector<RecipeSyncData>& recipes, uint32_t hash) {
+        Header h = {MAGIC, FORMAT, (uint8_t)recipes.size(), hash};
+        std::vector<uint8_t> blob(sizeof(h) + recipes.size() * sizeof(RecipeSyncData));
+        memcpy(blob.data(), &h, sizeof(h));
+        memcpy(blob.data() + sizeof(h), recipes.data(), recipes.size() * sizeof(RecipeSyncData));
+
+        Preferences prefs;
+        if (!prefs.begin(NVS_NAMESPACE, false)) return false;
+        bool ok = prefs.putBytes(KEY_RECIPES, blob.data(), blob.size()) == blob.size();
+        prefs.end();
+        return ok;
+    }
+
+    static bool loadPumps(PumpSyncData& out, uint32_t& hash) {
+        Preferences prefs;
+        if (!prefs.begin(NVS_NAMESPACE, true)) return false;
+
+        bool ok = false;
+        uint8_t blob[sizeof(Header) + sizeof(PumpSyncData)];
+        if (prefs.getBytesLength(KEY_PUMPS) == sizeof(blob)) {
+            prefs.getBytes(KEY_PUMPS, blob, sizeof(blob));
+
+            Header h;
+            memcpy(&h, blob, sizeof(h));
+            memcpy(&out, blob + sizeof(h), sizeof(out));
+            ok = (h.magic == MAGIC && h.format == FORMAT && remote_pumps_hash(out) == h.hash);
+            hash = h.hash;
+        }
+        prefs.end();
+        return ok;
+    }
+
+    static bool savePumps(const PumpSyncData& pumps, uint32_t hash) {
+        Header h = {MAGIC, FORMAT, 1, hash};
+        uint8_t blob[sizeof(h) + sizeof(pumps)];
+        memcpy(blob, &h, sizeof(h));
+        memcpy(blob + sizeof(h), &pumps, sizeof(pumps));
+
+        Preferences prefs;
+        if (!prefs.begin(NVS_NAMESPACE, false)) return false;
+        bool ok = prefs.putBytes(KEY_PUMPS, blob, sizeof(blob)) == sizeof(blob);
+        prefs.end();
+        return ok;
+    }
+
+private:
+    struct Header {
+        uint16_t magic;
+        uint8_t format; // bump when RecipeSyncData / PumpSyncData change layout
+        uint8_t count;
+        uint32_t hash;
+    };
+
+    static constexpr uint16_t MAGIC = 0xCA7A;
+    static constexpr uint8_t FORMAT = 2;
+    static constexpr const char* NVS_NAMESPACE = "catalog";
+    static constexpr const char* KEY_RECIPES = "recipes";
+    static constexpr const char* KEY_PUMPS = "pumps";
+};
+
+#endif // CATALOG_CACHE_HPP
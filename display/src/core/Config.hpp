@@ -102,14 +102,39 @@
 #endif
 
 
+// --- Boot ---
+#define BOOT_FIRST_FRAME_BUDGET_MS 1000 // Warn in the trace when the first frame is later than this
+#define BOOT_TRACE_MAX_STAGES 24
+#define RADIO_TASK_CORE 0               // Wi-Fi / ESP-NOW bring-up runs here, UI stays on the loop core
+#define RADIO_TASK_STACK 4096
+#define ESPNOW_PROBE_TIMEOUT_MS 300     // Wait for the controller on the cached channel
+#define ESPNOW_SWEEP_DWELL_MS 150       // Per channel while sweeping
+#define ESPNOW_MAX_CHANNEL 13
+#define ESPNOW_RETRY_MS 10000          // Pause between background searches while the controller is silent
+// #define BOOT_PANEL_TEST              // Blue screen flash after gfx->begin() to check the RGB wiring
+
+// --- Pumps ---
+#define PUMP_CALIBRATION_COALESCE_MS 300 // Slider releases within this window go out as one update
+
+// --- Drink orders ---
+#define ORDER_QUEUE_LEN 4         // Pending orders; more are refused in the UI
+#define ORDER_RETRY_BASE_MS 250   // First retry, doubled per attempt
+#define ORDER_RETRY_MAX_MS 4000
+#define ORDER_MAX_ATTEMPTS 6
+#define ORDER_TIMEOUT_MS 30000    // Give up on an order this long after it was queued
+#define ORDER_EVENT_RING 8        // Link / ACK results waiting for the UI loop, one slot stays free
+
+
 // --- Application Defaults (Mocks) ---
 #define SYNC_RETRY_INTERVAL_MS 5000
+#define MAX_RECIPES 32 // Capacity reserved up front; larger catalogues still work but allocate
 
 #include <vector>
 #include "models.hpp"
 
-inline std::vector<ICocktail> getDefaultMockCocktails() {
-    return {
+// Built once; callers copy the entries they need
+inline const std::vector<ICocktail>& getDefaultMockCocktails() {
+    static const std::vector<ICocktail> mocks = {
         {"Cocacola", nullptr, 0xFF0000, {{"Cocacola", 1, 200}}},
         {"Orange Juice", nullptr, 0xFFA500, {{"Orange", 2, 200}}},
         {"Vodka shot", nullptr, 0x00FFFF, {{"Vodka", 3, 50}}},
@@ -119,6 +144,7 @@ inline std::vector<ICocktail> getDefaultMockCocktails() {
         {"Tequila Sun", nullptr, 0xFF4500, {{"Tequila", 3, 50}, {"Orange", 2, 120}, {"Grenadine", 4, 10}}},
         {"Shirley T.", nullptr, 0xFF69B4, {{"Orange", 2, 100}, {"Grenadine", 4, 20}, {"Cocacola", 1, 50}}}
     };
+    return mocks;
 }
 
 inline IPumpSettings getDefaultPumpSettings() {
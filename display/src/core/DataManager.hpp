@@ -3,11 +3,40 @@
 
 #include <Arduino.h>
 #include <vector>
+#include <atomic>
+#include <mutex>
 #include "remote_protocol.hpp"
 #include "models.hpp"
 #include "Config.hpp"
-#include "../ui/assets/icons.h"
+#include "CatalogCache.hpp"
+#include "RecipeStore.hpp"
+#include "MetadataRegistry.hpp"
 
+/**
+ * @brief One published state of the catalogue, never modified after publish
+ */
+struct CatalogSnapshot {
+    RecipeStore recipes{MAX_RECIPES};
+    IPumpSettings pumps = getDefaultPumpSettings();
+    bool recipesSynced = false;
+    bool usingMocks = false;
+    bool usingCache = false; // Showing the NVS copy, controller not heard yet
+    bool pumpsFromCache = false; // Pump settings are the NVS copy, controller not heard yet
+    uint32_t version = 0;
+};
+
+/**
+ * @brief Catalogue shared by the ESP-NOW callback (writer) and the LVGL loop (reader)
+ *
+ * Writers serialize on writeLock, change the private working copy and
+ * publish a full copy of it with an atomic pointer swap. The LVGL loop reads
+ * the current snapshot without locking; references stay valid until it calls
+ * releaseSnapshots() between frames, which recycles the snapshots retired
+ * meanwhile. Only the LVGL task may hold snapshot references.
+ *
+ * A recipe sync is staged as wire records and applied in one publish when
+ * its last part arrives, so the UI never sees half a catalogue.
+ */
 class DataManager {
 public:
     static DataManager& getInstance() {
@@ -15,125 +44,322 @@ public:
         return instance;
     }
 
+    // --- Readers (LVGL task) ---
+    const CatalogSnapshot& snapshot() const { return *current.load(std::memory_order_acquire); }
+    uint32_t getVersion() const { return snapshot().version; } // Increases with every publish
+
+    bool isRecipesSynced() const { return snapshot().recipesSynced; }
+    bool isUsingMocks() const { return snapshot().usingMocks; }
+    bool isUsingCache() const { return snapshot().usingCache; }
+    const RecipeStore& getRecipes() const { return snapshot().recipes; }
+    const ICocktail* getRecipe(RecipeHandle h) const { return snapshot().recipes.get(h); } // nullptr once removed
+    RecipeHandle findRecipe(const char* name) const { return snapshot().recipes.find(name); }
+    const IPumpSettings& getPumpSettings() const { return snapshot().pumps; }
+
+    // Quiescent point of the LVGL task: no snapshot references are held here
+    void releaseSnapshots() {
+        std::lock_guard<std::mutex> lock(reclaimLock);
+        while (!retired.empty()) {
+            if (pool.size() < SNAPSHOT_POOL) pool.push_back(retired.back());
+            else delete retired.back();
+            retired.pop_back();
+        }
+    }
+
     // --- Recipes ---
-    bool isRecipesSynced() const { return recipesSynced; }
-    bool isUsingMocks() const { return usingMocks; }
-    const std::vector<ICocktail>& getRecipes() const { return recipes; }
-    
     void clearRecipes() { 
-        recipes.clear(); 
-        recipesSynced = false;
-        usingMocks = false;
+        std::lock_guard<std::mutex> lock(writeLock);
+        work.recipes.clear(); 
+        pendingRecords.clear();
+        syncRecords.clear();
+        recipesHash = 0;
+        work.recipesSynced = false;
+        work.usingMocks = false;
+        work.usingCache = false;
+        publish();
     }
 
     void addRecipe(const RecipeSyncData& data) {
-        // Clear if new sync session starts (Index 0) OR if we were using mocks
-        if (data.index == 0 || usingMocks) {
-            if (usingMocks) printf("[DataManager] Real data received. Clearing Mocks.\n");
-            else printf("[DataManager] New Sync Session (Index 0). Clearing old data.\n");
-            
-            recipes.clear();
-            recipesSynced = false;
-            usingMocks = false;
-        }
-
-        if (!recipesSynced) {
-            recipesSynced = true; // Mark as syncing started
+        std::lock_guard<std::mutex> lock(writeLock);
+        if (data.index == 0) {
+            printf("[DataManager] New Sync Session (Index 0).\n");
+            pendingRecords.clear();
         }
+        pendingRecords.push_back(data);
 
-        ICocktail c;
-        c.name = String(data.name);
-        mapMetadata(c);
+        // Last part of a complete session: apply it as a whole
+        if (data.total > 0 && data.index == data.total - 1 && pendingRecords.size() == data.total) {
+            if (work.usingMocks) {
+                printf("[DataManager] Real data received. Clearing Mocks.\n");
+                work.recipes.clear();
+            }
+            // Recipes that come back keep their handles, the others are dropped
+            work.recipes.beginSession();
+            for (const auto& d : pendingRecords) {
+                ICocktail c;
+                fillFromSyncData(c, d);
+                work.recipes.upsert(c);
+            }
+            work.recipes.endSession();
+            work.recipesSynced = true;
+            work.usingMocks = false;
+            work.usingCache = false;
+            syncRecords.swap(pendingRecords);
+            pendingRecords.clear();
 
-        static const char* PUMP_NAMES[] = {"Cocacola", "Orange Juice", "Vodka", "Grenadine"};
-        for (int i=0; i<4; i++) {
-             if (data.ingredientsMl[i] > 0) {
-                 c.ingredients.push_back({PUMP_NAMES[i], i+1, (int)data.ingredientsMl[i]});
-             }
+            // This is the catalogue to boot with next time
+            uint32_t hash = remote_recipes_hash(syncRecords.data(), syncRecords.size());
+            if (hash != recipesHash) {
+                recipesHash = hash;
+                recipesDirty = true;
+            }
+            publish();
         }
-        
-        recipes.push_back(c);
-        lastUpdateTime = millis();
     }
 
     void addRecipeFromConfig(const ICocktail& cocktail) {
-        if (usingMocks) {
-            recipes.clear(); 
-            usingMocks = false;
+        std::lock_guard<std::mutex> lock(writeLock);
+        if (work.usingMocks) {
+            work.recipes.clear(); 
+            work.usingMocks = false;
         }
-        if (!recipesSynced) {
-            recipes.clear();
-            recipesSynced = true;
+        if (!work.recipesSynced) {
+            work.recipes.clear();
+            work.recipesSynced = true;
         }
         ICocktail c = cocktail;
         mapMetadata(c); 
-        recipes.push_back(c);
-        lastUpdateTime = millis();
+        work.recipes.upsert(c);
+        publish();
     }
 
     void updateRecipe(const ICocktail& updatedCocktail) {
-        for (auto& c : recipes) {
-            if (c.name == updatedCocktail.name) {
-                c.ingredients = updatedCocktail.ingredients;
-                lastUpdateTime = millis();
-                printf("[DataManager] Optimistic Update for: %s\n", c.name.c_str());
-                return;
-            }
+        std::lock_guard<std::mutex> lock(writeLock);
+        ICocktail* c = work.recipes.get(work.recipes.find(updatedCocktail.name.c_str()));
+        if (c) {
+            c->ingredients = updatedCocktail.ingredients;
+            printf("[DataManager] Optimistic Update for: %s\n", c->name.c_str());
+            publish();
+            return;
         }
         printf("[DataManager] Warning: Recipe not found for update: %s\n", updatedCocktail.name.c_str());
     }
 
     void loadMocks() {
-        if (recipesSynced && !recipes.empty() && !usingMocks) return; // Don't overwrite REAL live data
+        std::lock_guard<std::mutex> lock(writeLock);
+        if (work.recipesSynced && !work.recipes.empty() && !work.usingMocks) return; // Don't overwrite REAL live data
         
         printf("[DataManager] Loading Mocks.\n");
-        auto mocks = getDefaultMockCocktails();
-        recipes.clear();
-        for (const auto& m : mocks) {
+        work.recipes.clear();
+        for (const auto& m : getDefaultMockCocktails()) {
             ICocktail c = m;
             mapMetadata(c);
-            recipes.push_back(c);
+            work.recipes.upsert(c);
         }
-        recipesSynced = true; 
-        usingMocks = true;    // Mark as Mocks
-        lastUpdateTime = millis();
+        work.recipesSynced = true; 
+        work.usingMocks = true;    // Mark as Mocks
+        publish();
+    }
+
+    // --- Metadata ---
+    int pumpForIngredient(const char* ingredient) {
+        std::lock_guard<std::mutex> lock(writeLock);
+        return metadata.pumpFor(ingredient);
     }
 
 
     // --- Pumps ---
-    const IPumpSettings& getPumpSettings() const { return pumps; }
-    
     void updatePumps(const PumpSyncData& data) {
-        for(int i=0; i<4; i++) {
-            pumps.pwm[i] = data.pwm[i];
-            pumps.timeMs[i] = (int)(data.calibration[i] * 1000.0f);
+        std::lock_guard<std::mutex> lock(writeLock);
+        applyPumps(data);
+        work.pumpsFromCache = false;
+        uint32_t hash = remote_pumps_hash(data);
+        if (hash != pumpsHash) {
+            pumpRecord = data;
+            pumpsHash = hash;
+            pumpsDirty = true;
         }
-        pumps.synced = true;
-        lastUpdateTime = millis();
+        publish();
+    }
+
+    // --- Persistent Cache ---
+    uint32_t getRecipesHash() {
+        std::lock_guard<std::mutex> lock(writeLock);
+        return work.usingMocks ? 0 : recipesHash;
     }
 
-    unsigned long getLastUpdate() const { return lastUpdateTime; }
+    uint32_t getPumpsHash() {
+        std::lock_guard<std::mutex> lock(writeLock);
+        return pumpsHash;
+    }
+
+    // Boot: show the last confirmed catalogue until the controller answers
+    void loadCache() {
+        unsigned long start = micros();
+        std::vector<RecipeSyncData> cached;
+        uint32_t hash = 0;
+        std::lock_guard<std::mutex> lock(writeLock);
+        if (CatalogCache::loadRecipes(cached, hash) && !cached.empty()) {
+            work.recipes.clear();
+            for (const auto& d : cached) {
+                ICocktail c;
+                fillFromSyncData(c, d);
+                work.recipes.upsert(c);
+            }
+            syncRecords = cached;
+            recipesHash = hash;
+            work.recipesSynced = true;
+            work.usingMocks = false;
+            work.usingCache = true;
+        }
+
+        PumpSyncData p;
+        if (CatalogCache::loadPumps(p, hash)) {
+            applyPumps(p);
+            pumpRecord = p;
+            pumpsHash = hash;
+            work.pumpsFromCache = true;
+        }
+        publish();
+        printf("[DataManager] Cache: %d recipes (hash %08lX), pumps %s, %lu us\n",
+               (int)work.recipes.size(), (unsigned long)recipesHash, work.pumpsFromCache ? "OK" : "none", micros() - start);
+    }
+
+    // Controller answered REMOTE_CMD_SYNC_UNCHANGED
+    void confirmRecipes() {
+        std::lock_guard<std::mutex> lock(writeLock);
+        if (work.usingCache) {
+            printf("[DataManager] Controller confirmed cached recipes.\n");
+            work.usingCache = false;
+            publish();
+        }
+    }
+
+    void confirmPumps() {
+        std::lock_guard<std::mutex> lock(writeLock);
+        if (work.pumpsFromCache) {
+            printf("[DataManager] Controller confirmed cached pumps.\n");
+            work.pumpsFromCache = false;
+            publish();
+        }
+    }
+
+    // Flash writes stay out of the radio callback: call from the UI loop
+    void saveCacheIfDirty() {
+        bool saveRecipes = false, savePumps = false;
+        uint32_t rHash = 0, pHash = 0;
+        PumpSyncData p;
+        {
+            std::lock_guard<std::mutex> lock(writeLock);
+            if (recipesDirty) {
+                recipesDirty = false;
+                saveRecipes = true;
+                saveRecords.assign(syncRecords.begin(), syncRecords.end());
+                rHash = recipesHash;
+            }
+            if (pumpsDirty) {
+                pumpsDirty = false;
+                savePumps = true;
+                p = pumpRecord;
+                pHash = pumpsHash;
+            }
+        }
+        // No lock held while writing flash
+        if (saveRecipes) {
+            bool ok = CatalogCache::saveRecipes(saveRecords, rHash);
+            printf("[DataManager] Saved %d recipes to NVS: %s\n", (int)saveRecords.size(), ok ? "OK" : "FAILED");
+        }
+        if (savePumps) {
+            bool ok = CatalogCache::savePumps(p, pHash);
+            printf("[DataManager] Saved pump settings to NVS: %s\n", ok ? "OK" : "FAILED");
+        }
+    }
 
 private:
-    DataManager() {}
+    DataManager() {
+        // Models are inline (models.hpp): with the capacity reserved once, syncs do not touch the heap
+        pendingRecords.reserve(MAX_RECIPES);
+        syncRecords.reserve(MAX_RECIPES);
+        saveRecords.reserve(MAX_RECIPES);
+        retired.reserve(SNAPSHOT_POOL + 2);
+        pool.reserve(SNAPSHOT_POOL);
+        current.store(new CatalogSnapshot(work), std::memory_order_release);
+    }
+
+    // writeLock held. Snapshots come from the pool when the LVGL loop has returned some.
+    void publish() {
+        work.version++;
+        CatalogSnapshot* next = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(reclaimLock);
+            if (!pool.empty()) {
+                next = pool.back();
+                pool.pop_back();
+            }
+        }
+        if (next) *next = work;
+        else next = new CatalogSnapshot(work);
+
+        CatalogSnapshot* old = current.exchange(next, std::memory_order_acq_rel);
+        std::lock_guard<std::mutex> lock(reclaimLock);
+        retired.push_back(old);
+    }
+
+    void fillFromSyncData(ICocktail& c, const RecipeSyncData& data) {
+        char name[RECIPE_NAME_LEN + 1];
+        memcpy(name, data.name, RECIPE_NAME_LEN); // wire name may fill all 32 bytes
+        name[RECIPE_NAME_LEN] = '\0';
+        c.name = name;
+        c.ingredients.clear();
+        if (data.iconId != RECIPE_ICON_NONE) {
+            metadata.setRecipe(name, data.iconId, data.color); // Controller knows better than the name rules
+        }
+        mapMetadata(c);
+
+        for (int i=0; i<4; i++) {
+             if (data.ingredientsMl[i] > 0) {
+                 c.ingredients.push_back({metadata.pumpName(i+1), i+1, (int)data.ingredientsMl[i]});
+             }
+        }
+    }
+
+    void applyPumps(const PumpSyncData& data) {
+        for(int i=0; i<4; i++) {
+            work.pumps.pwm[i] = data.pwm[i];
+            work.pumps.timeMs[i] = (int)(data.calibration[i] * 1000.0f);
+        }
+        work.pumps.synced = true;
+    }
 
     void mapMetadata(ICocktail& c) {
-        // Centralized logic for icon/color assignment
-        if (c.name.indexOf("Coca") >= 0) { c.icon = ICON_COCKTAIL_COCA_COLA; c.color = 0xFF0000; }
-        else if (c.name.indexOf("Orange") >= 0) { c.icon = ICON_COCKTAIL_GIN_TONIC; c.color = 0xFFA500; }
-        else if (c.name.indexOf("Vodka") >= 0) { c.icon = ICON_COCKTAIL_VODKA; c.color = 0x00FFFF; }
-        else if (c.name.indexOf("Sex") >= 0) { c.icon = ICON_COCKTAIL_SEX_ON_BEACH; c.color = 0xFF1493; }
-        else if (c.name.indexOf("Tequila") >= 0) { c.icon = ICON_COCKTAIL_PORN_STAR; c.color = 0xFF4500; }
-        else if (c.name.indexOf("Gin") >= 0) { c.icon = ICON_COCKTAIL_GIN_TONIC; c.color = 0xADD8E6; }
-        else { c.icon = ICON_COCKTAIL_VODKA; c.color = 0x888888; }
+        MetadataRegistry::RecipeMeta m = metadata.resolve(c.name.c_str());
+        c.icon = MetadataRegistry::iconImage(m.iconId);
+        c.color = m.color;
     }
     
-    std::vector<ICocktail> recipes;
-    bool recipesSynced = false;
-    bool usingMocks = false;
+    static const size_t SNAPSHOT_POOL = 2;
+
+    // Writer state, guarded by writeLock
+    std::mutex writeLock;
+    CatalogSnapshot work;
+    MetadataRegistry metadata;
+
+    // Wire records: the session being received, and the last complete sync (persisted as-is)
+    std::vector<RecipeSyncData> pendingRecords;
+    std::vector<RecipeSyncData> syncRecords;
+    std::vector<RecipeSyncData> saveRecords; // copy handed to the flash write
+    uint32_t recipesHash = 0;
+    bool recipesDirty = false;
     
-    IPumpSettings pumps = getDefaultPumpSettings();
-    unsigned long lastUpdateTime = 0;
+    PumpSyncData pumpRecord = {};
+    uint32_t pumpsHash = 0;
+    bool pumpsDirty = false;
+
+    // Published state
+    std::atomic<CatalogSnapshot*> current{nullptr};
+    std::mutex reclaimLock;                // guards retired / pool only, never held for long
+    std::vector<CatalogSnapshot*> retired; // swapped out, may still be read until releaseSnapshots()
+    std::vector<CatalogSnapshot*> pool;
 };
 
 #endif // DATA_MANAGER_HPP
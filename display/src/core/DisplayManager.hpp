@@ -7,6 +7,7 @@
 #include "TouchDriver.hpp"
 #include "../ui/ui.h"
 #include "ESPNowManager.hpp"
+#include "BootTrace.hpp"
 #include <WiFi.h>
 
 class DisplayManager {
@@ -17,8 +18,17 @@ public:
     }
 
     bool begin() {
-        delay(5000); 
+        BootTrace& trace = BootTrace::getInstance();
+        trace.mark("display: begin");
         printf("\n\n>>> HARDWARE INIT (Sync v3.2.1) <<<\n");
+
+        // Last confirmed catalogue first, so the UI never starts empty and sync requests carry its hash
+        DataManager::getInstance().loadCache();
+        trace.mark("cache loaded");
+
+        // Scan + ESP-NOW init on the other core while the panel and UI come up
+        ESPNowManager::getInstance().beginAsync();
+
         printf("Configuring RGB Panel...\n");
         
         if (!psramFound()) {
@@ -47,14 +57,15 @@ public:
             return false;
         }
 
-        Serial.println("GFX OK. Backlight ON.");
+        Serial.println("GFX OK.");
+        trace.mark("display: panel");
 
-        // Turn on backlight and quick visual test
         pinMode(TFT_BL, OUTPUT);
+#ifdef BOOT_PANEL_TEST
         digitalWrite(TFT_BL, HIGH);
-        
         gfx->fillScreen(BLUE); // Visual test: blue screen means driver works
         delay(200);
+#endif
         gfx->fillScreen(BLACK);
 
         Serial.println("Initializing LVGL...");
@@ -93,21 +104,33 @@ public:
         lv_indev_t *indev = lv_indev_create();
         lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
         lv_indev_set_read_cb(indev, touchpad_read_cb);
-
-        printf("Initializing ESP-NOW Manager...\n");
-        if (!ESPNowManager::getInstance().begin()) {
-            printf("WARNING: ESP-NOW Init failed. Running in Offline/Mock mode.\n");
-        }
+        trace.mark("lvgl + touch");
 
         printf("Initializing UI...\n");
         ui_init();
+        trace.mark("ui built");
+
+        // Render before lighting the backlight: no flash of an empty panel
+        lv_refr_now(disp);
+        digitalWrite(TFT_BL, HIGH);
+        trace.mark("first frame");
+
+        uint32_t firstFrameMs = trace.elapsedMs();
+        if (firstFrameMs > BOOT_FIRST_FRAME_BUDGET_MS) {
+            printf("[Boot] WARNING: first frame at %lu ms (budget %d ms)\n", (unsigned long)firstFrameMs, BOOT_FIRST_FRAME_BUDGET_MS);
+        }
 
-        printf("System ready\n");
+        printf("System ready (send 'boot' for the boot trace)\n");
         return true;
     }
 
     void update() {
         lv_task_handler();
+        DataManager::getInstance().releaseSnapshots(); // UI holds no snapshot references here
+        DataManager::getInstance().saveCacheIfDirty();
+        ESPNowManager::getInstance().flushPumpCalibration();
+        ESPNowManager::getInstance().pumpOrders();
+        BootTrace::getInstance().pollSerial();
         delay(5);
     }
 
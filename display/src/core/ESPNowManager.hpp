@@ -6,11 +6,28 @@
 #include <esp_wifi.h>
 #include <esp_now.h>
 #include <WiFi.h>
+#include <Preferences.h>
 #include "remote_protocol.hpp"
+#include "remote_frame.hpp"
 #include "DataManager.hpp"
+#include "BootTrace.hpp"
+#include "OrderQueue.hpp"
+
+// Drink order link state, written by the radio callbacks and consumed by ESPNowManager::pumpOrders()
+static uint8_t controller_mac[6];              // Written once, before controller_known
+static volatile bool controller_known = false; // First controller reply seen, orders can be unicast
+static volatile uint16_t order_on_air = 0;     // Order in the unicast frame awaiting onDataSent, 0 = none
+static OrderEventRing order_events;            // Link results and ACKs, by order id
 
 // Static callback for ESP-NOW
 static void onDataSent(const uint8_t *mac_addr, esp_now_send_status_t status) {
+    // Only orders are unicast, broadcasts are never acknowledged
+    uint16_t id = order_on_air;
+    if (id && controller_known && memcmp(mac_addr, controller_mac, 6) == 0) {
+        order_on_air = 0;
+        order_events.push(id, status == ESP_NOW_SEND_SUCCESS ? OrderEventRing::ORDER_EVENT_LINK_OK
+                                                             : OrderEventRing::ORDER_EVENT_LINK_LOST);
+    }
     if (status == ESP_NOW_SEND_SUCCESS) {
         printf("[ESP-NOW] Delivery Success to %02X:%02X:%02X:%02X:%02X:%02X\n", 
                mac_addr[0], mac_addr[1], mac_addr[2], mac_addr[3], mac_addr[4], mac_addr[5]);
@@ -24,6 +41,8 @@ static void onDataSent(const uint8_t *mac_addr, esp_now_send_status_t status) {
 static struct_message last_sync_data;
 static unsigned long last_sync_time = 0;
 static bool is_server_connected = false;
+static volatile uint32_t controller_rx = 0; // Frames from the controller, for the channel probe
+static volatile bool peer_compact = false; // The controller itself sent a compact frame: answer in kind
 static std::function<void(const RecipeSyncData&)> on_recipe_recv_cb = nullptr;
 
 // Conditional Signature for ESP-IDF 5.x / Arduino ESP32 v3.0+ vs Legacy
@@ -36,10 +55,23 @@ static void onDataRecv(const uint8_t *mac, const uint8_t *data, int len) {
     printf("[ESP-NOW] Packet Recv from %02X:%02X:%02X:%02X:%02X:%02X | Len: %d\n", 
            mac[0], mac[1], mac[2], mac[3], mac[4], mac[5], len);
     
-    if (len == sizeof(struct_message)) {
-        struct_message msg;
-        memcpy(&msg, data, sizeof(msg));
-        printf("[ESP-NOW] Message ID: %d\n", msg.id);
+    struct_message msg;
+    bool compact = false;
+    if (len > 0 && remote_frame_decode(data, (size_t)len, msg, &compact)) {
+        printf("[ESP-NOW] Message ID: %d%s\n", msg.id, compact ? " (compact)" : "");
+
+        // Other displays broadcast requests too: only replies count as the controller
+        bool fromController = msg.id == REMOTE_CMD_SYNC_RESPONSE || msg.id == REMOTE_CMD_RECIPE_DATA ||
+                              msg.id == REMOTE_CMD_SYNC_UNCHANGED || msg.id == REMOTE_CMD_ORDER_ACK;
+        if (fromController) {
+            controller_rx++;
+            if (!controller_known) {
+                memcpy(controller_mac, mac, 6);
+                controller_known = true;
+            }
+            // A compact display request must not switch our orders to a format the controller may not read
+            if (compact && memcmp(mac, controller_mac, 6) == 0) peer_compact = true;
+        }
         
         if (msg.id == REMOTE_CMD_SYNC_RESPONSE) { // Sync Response (Pumps)
             last_sync_data = msg;
@@ -59,8 +91,23 @@ static void onDataRecv(const uint8_t *mac, const uint8_t *data, int len) {
                 on_recipe_recv_cb(msg.recipeData);
             }
         }
+        else if (msg.id == REMOTE_CMD_SYNC_UNCHANGED) { // Our cached copy is current
+            is_server_connected = true;
+            last_sync_time = millis();
+            if (msg.idReading == REMOTE_CMD_RECIPE_SYNC_REQUEST) {
+                DataManager::getInstance().confirmRecipes();
+            } else if (msg.idReading == REMOTE_CMD_SYNC_REQUEST) {
+                DataManager::getInstance().confirmPumps();
+            }
+            printf("[ESP-NOW] Controller: cache unchanged (req %d)\n", msg.idReading);
+        }
+        else if (msg.id == REMOTE_CMD_ORDER_ACK) {
+            is_server_connected = true;
+            last_sync_time = millis();
+            order_events.push((uint16_t)msg.idReading, OrderEventRing::ORDER_EVENT_ACK);
+        }
     } else {
-        printf("[ESP-NOW] Size mismatch or noise. Ignoring.\n");
+        printf("[ESP-NOW] Unknown frame or noise. Ignoring.\n");
     }
 }
 
@@ -71,30 +118,25 @@ public:
         return instance;
     }
 
+    // Radio bring-up off the UI path: the first frame does not wait for the scan
+    void beginAsync() {
+        xTaskCreatePinnedToCore(radioTask, "radio_init", RADIO_TASK_STACK, this, 1, NULL, RADIO_TASK_CORE);
+    }
+
+    bool isReady() const { return ready; }
+
     bool begin() {
+        BootTrace::getInstance().mark("radio: start");
         // Set device as a Wi-Fi Station
         WiFi.mode(WIFI_STA);
         esp_wifi_set_ps(WIFI_PS_NONE); // Disable power save to prevent display flickering
         WiFi.disconnect();
 
-
-
-        // Sync channel with the target network defined in secrets.h
-        printf("[ESP-NOW] Searching for network: %s\n", TARGET_WIFI_SSID);
-        
-        delay(500); 
-        int32_t channel = getWiFiChannel(TARGET_WIFI_SSID);
-        
-        if (channel > 0) {
-            printf("[ESP-NOW] Found network '%s' on channel %d. Switching radio...\n", TARGET_WIFI_SSID, (int)channel);
-            
-            esp_wifi_set_promiscuous(true);
-            esp_wifi_set_channel(channel, WIFI_SECOND_CHAN_NONE);
-            esp_wifi_set_promiscuous(false);
-        } else {
-            printf("[ESP-NOW] Network '%s' not found. Defaulting to channel 1. (Check secrets.h)\n", TARGET_WIFI_SSID);
-            channel = 1;
-        }
+        // Start on the channel that worked last time, no scan
+        savedChannel = loadChannel();
+        int32_t channel = savedChannel > 0 ? savedChannel : 1;
+        printf("[ESP-NOW] Starting on %s channel %d\n", savedChannel > 0 ? "cached" : "default", (int)channel);
+        setChannel(channel);
 
         // Init ESP-NOW
         if (esp_now_init() != ESP_OK) {
@@ -106,13 +148,12 @@ public:
         esp_now_register_recv_cb(onDataRecv);
 
         printf("[ESP-NOW] Init OK. MAC: %s\n", WiFi.macAddress().c_str());
-        printf("[ESP-NOW] Current Radio Channel: %d (Target: %d)\n", (int)WiFi.channel(), (int)channel);
 
-        // Register peer
+        // Register peer (channel 0 = follow the current radio channel, so the sweep needs no re-add)
         esp_now_peer_info_t peerInfo;
         memset(&peerInfo, 0, sizeof(peerInfo));
         memcpy(peerInfo.peer_addr, broadcastAddress, 6);
-        peerInfo.channel = channel; 
+        peerInfo.channel = 0; 
         peerInfo.encrypt = false;
         
         if (esp_now_add_peer(&peerInfo) != ESP_OK) {
@@ -121,6 +162,20 @@ public:
         }
 
         printf("[ESP-NOW] Peer Broadcast Added OK\n");
+        ready = true;
+        BootTrace::getInstance().mark("radio: ESP-NOW ready");
+
+        // Is the controller on this channel?
+        if (probe(ESPNOW_PROBE_TIMEOUT_MS)) {
+            printf("[ESP-NOW] Controller answered on channel %d\n", (int)channel);
+            BootTrace::getInstance().mark("radio: probe OK");
+            saveChannel(channel);
+            return true;
+        }
+        BootTrace::getInstance().mark("radio: probe failed");
+
+        searchController();
+        BootTrace::getInstance().mark("radio: channel search");
         return true;
     }
 
@@ -128,14 +183,16 @@ public:
         struct_message msg;
         memset(&msg, 0, sizeof(msg));
         msg.id = REMOTE_CMD_SYNC_REQUEST; // Request Sync
-        esp_now_send(broadcastAddress, (uint8_t *) &msg, sizeof(msg));
+        msg.idReading = (int)DataManager::getInstance().getPumpsHash();
+        sendMessage(msg);
     }
 
     void requestRecipeSync() {
         struct_message msg;
         memset(&msg, 0, sizeof(msg));
         msg.id = REMOTE_CMD_RECIPE_SYNC_REQUEST;
-        esp_now_send(broadcastAddress, (uint8_t *) &msg, sizeof(msg));
+        msg.idReading = (int)DataManager::getInstance().getRecipesHash();
+        sendMessage(msg);
         printf("[ESP-NOW] Requested Recipe Sync...\n");
     }
 
@@ -150,39 +207,116 @@ public:
 
     struct_message& getSyncData() { return last_sync_data; }
 
-    void sendDrinkSelection(const String& drinkName) {
+    // Queues the order; pumpOrders() sends it. Returns its id, 0 when the queue is full.
+    uint16_t sendDrinkSelection(const String& drinkName) {
+        uint16_t id = orders.push(drinkName.c_str(), millis());
+        if (id == 0) {
+            printf("[Orders] Queue full (%d), refusing %s\n", ORDER_QUEUE_LEN, drinkName.c_str());
+            return 0;
+        }
+        printf("[Orders] #%u %s queued (%d pending)\n", id, drinkName.c_str(), (int)orders.size());
+        pumpOrders();
+        return id;
+    }
+
+    const OrderQueue& getOrders() const { return orders; }
+
+    // Call from the UI loop: ACKs, retries with backoff, timeouts
+    void pumpOrders() {
+        uint32_t now = millis();
+
+        OrderEventRing::Event ev;
+        while (order_events.pop(ev)) {
+            switch (ev.kind) {
+                case OrderEventRing::ORDER_EVENT_ACK:
+                    if (orders.acknowledge(ev.id, now)) logFinished();
+                    break;
+                case OrderEventRing::ORDER_EVENT_LINK_OK:
+                    // Older controllers never send REMOTE_CMD_ORDER_ACK: the link ACK is all there is
+                    if (!peer_compact && orders.acknowledge(ev.id, now)) logFinished();
+                    break;
+                case OrderEventRing::ORDER_EVENT_LINK_LOST:
+                    if (orders.linkFailed(ev.id)) printf("[Orders] #%u lost on the link, retrying\n", ev.id);
+                    break;
+            }
+        }
+
+        if (order_on_air && now - onAirSince > ORDER_RETRY_MAX_MS) order_on_air = 0; // onDataSent never came
+
+        uint32_t failed = orders.getMetrics().failed;
+        OrderQueue::Order* o = orders.due(now);
+        if (orders.getMetrics().failed != failed) logFinished();
+        // One unicast at a time, so every link result names its order
+        if (!o || order_on_air || !ready || !controller_known || !ensureControllerPeer()) return;
+
         struct_message msg;
         memset(&msg, 0, sizeof(msg));
-        
-        msg.id = REMOTE_CMD_DRINK_ORDER; 
-        strncpy(msg.choose, drinkName.c_str(), sizeof(msg.choose) - 1);
-        
-        printf("[ESP-NOW] Sending Drink Order: %s ... ", drinkName.c_str());
-        esp_err_t result = esp_now_send(broadcastAddress, (uint8_t *) &msg, sizeof(msg));
-        
+        msg.id = REMOTE_CMD_DRINK_ORDER;
+        msg.idReading = o->id;
+        strncpy(msg.choose, o->name.c_str(), sizeof(msg.choose) - 1);
+
+        printf("[Orders] #%u %s attempt %d ... ", o->id, o->name.c_str(), o->attempts + 1);
+        // Controllers with compact frames ignore ids they already took, so a missing ACK
+        // can be resent on the timer. Older ones would make the drink twice: they only
+        // get a resend when the link reports the frame lost.
+        uint16_t id = o->id;
+        order_on_air = id;
+        onAirSince = now;
+        esp_err_t result = sendMessage(msg, controller_mac);
+        orders.markSent(*o, now, peer_compact);
+
         if (result == ESP_OK) {
             printf("Queued OK\n");
         } else {
+            // Never left the radio: no onDataSent will come, retry like a lost frame
+            order_on_air = 0;
+            orders.linkFailed(id);
             printf("Error! (Code: %d)\n", result);
         }
     }
 
-    void sendPumpCalibration(int pumpId, int pwm, int timeMs) {
+    // Remembers the pump's new values; flushPumpCalibration() sends them once the sliders settle
+    void queuePumpCalibration(int pumpId, int pwm, int timeMs) {
+        if (pumpId < 1 || pumpId > 4) return;
+        PumpCalibrationEntry& e = pendingPumps[pumpId - 1];
+        e.pump = (uint8_t)pumpId;
+        e.pwm = (uint16_t)constrain(pwm, 0, 0xFFFF);
+        e.timeMs = (uint16_t)constrain(timeMs, 0, 0xFFFF);
+        pendingMask |= 1 << (pumpId - 1);
+        pendingSince = millis();
+    }
+
+    // Call from the UI loop
+    void flushPumpCalibration() {
+        if (!pendingMask || millis() - pendingSince < PUMP_CALIBRATION_COALESCE_MS) return;
+        PumpCalibrationEntry entries[4];
+        uint8_t count = 0;
+        for (int i = 0; i < 4; i++) {
+            if (pendingMask & (1 << i)) entries[count++] = pendingPumps[i];
+        }
+        pendingMask = 0;
+        sendPumpCalibration(entries, count);
+    }
+
+    void sendPumpCalibration(const PumpCalibrationEntry* entries, uint8_t count) {
+        if (count == 0 || count > 4) return;
+
+        // Controllers without compact frames only know the text form
+        if (!peer_compact) {
+            for (uint8_t i = 0; i < count; i++) sendPumpCalibrationText(entries[i]);
+            return;
+        }
+
         struct_message msg;
         memset(&msg, 0, sizeof(msg));
-        
-        msg.id = REMOTE_CMD_PUMP_UPDATE;
-        // Server expects: "pump:ID:PWM:TIME_FLOAT"
-        // We have time in MS. Convert to seconds.
-        float timeSec = timeMs / 1000.0f;
-        
-        char cmd[64];
-        snprintf(cmd, sizeof(cmd), "pump:%d:%d:%.2f", pumpId, pwm, timeSec);
-        
-        strncpy(msg.choose, cmd, sizeof(msg.choose) - 1);
-        
-        printf("[ESP-NOW] Sending Pump Update: %s ... ", cmd);
-        esp_err_t result = esp_now_send(broadcastAddress, (uint8_t *) &msg, sizeof(msg));
+        msg.id = REMOTE_CMD_PUMP_CALIBRATION;
+        PumpCalibrationData data = {};
+        data.count = count;
+        memcpy(data.pumps, entries, count * sizeof(PumpCalibrationEntry));
+        msg.pumpCalibration = data;
+
+        printf("[ESP-NOW] Sending Pump Calibration (%d pumps) ... ", count);
+        esp_err_t result = sendMessage(msg);
         
         if (result == ESP_OK) {
             printf("OK\n");
@@ -199,7 +333,7 @@ public:
         msg.recipeData = data; // Copy data
         
         printf("[ESP-NOW] Sending Recipe Update: %s ... ", data.name);
-        esp_err_t result = esp_now_send(broadcastAddress, (uint8_t *) &msg, sizeof(msg));
+        esp_err_t result = sendMessage(msg);
         
         if (result == ESP_OK) {
             printf("OK\n");
@@ -211,6 +345,191 @@ public:
 private:
     ESPNowManager() {}
 
+    void sendPumpCalibrationText(const PumpCalibrationEntry& e) {
+        struct_message msg;
+        memset(&msg, 0, sizeof(msg));
+        
+        msg.id = REMOTE_CMD_PUMP_UPDATE;
+        // Server expects: "pump:ID:PWM:TIME_FLOAT"
+        // We have time in MS. Convert to seconds.
+        float timeSec = e.timeMs / 1000.0f;
+        
+        char cmd[64];
+        snprintf(cmd, sizeof(cmd), "pump:%d:%d:%.2f", e.pump, e.pwm, timeSec);
+        
+        strncpy(msg.choose, cmd, sizeof(msg.choose) - 1);
+        
+        printf("[ESP-NOW] Sending Pump Update: %s ... ", cmd);
+        esp_err_t result = sendMessage(msg);
+        
+        if (result == ESP_OK) {
+            printf("OK\n");
+        } else {
+            printf("Error! (%d)\n", result);
+        }
+    }
+
+    // Compact frame once the controller has shown it understands them, legacy otherwise
+    esp_err_t sendMessage(struct_message& msg, const uint8_t* dest = nullptr) {
+        if (!dest) dest = broadcastAddress;
+        if (peer_compact) {
+            uint8_t frame[REMOTE_FRAME_MAX];
+            size_t len = remote_frame_encode(msg, frame, sizeof(frame));
+            if (len > 0) return esp_now_send(dest, frame, len);
+        }
+        if (msg.id == REMOTE_CMD_SYNC_REQUEST || msg.id == REMOTE_CMD_RECIPE_SYNC_REQUEST) {
+            msg.temp = REMOTE_FRAME_VERSION; // We accept compact replies
+        }
+        return esp_now_send(dest, (uint8_t *) &msg, sizeof(msg));
+    }
+
+    // Unicast peer for orders, so they get link-layer ACKs and retries
+    bool ensureControllerPeer() {
+        if (controllerPeer) return true;
+        if (!esp_now_is_peer_exist(controller_mac)) {
+            esp_now_peer_info_t peerInfo;
+            memset(&peerInfo, 0, sizeof(peerInfo));
+            memcpy(peerInfo.peer_addr, controller_mac, 6);
+            peerInfo.channel = 0;
+            peerInfo.encrypt = false;
+            if (esp_now_add_peer(&peerInfo) != ESP_OK) {
+                printf("[ESP-NOW] Failed to add controller peer\n");
+                return false;
+            }
+        }
+        controllerPeer = true;
+        printf("[ESP-NOW] Controller peer %02X:%02X:%02X:%02X:%02X:%02X added\n",
+               controller_mac[0], controller_mac[1], controller_mac[2], controller_mac[3], controller_mac[4], controller_mac[5]);
+        return true;
+    }
+
+    void logFinished() {
+        const OrderQueue::Order& o = orders.lastFinished();
+        const OrderQueue::Metrics& m = orders.getMetrics();
+        if (o.state == OrderQueue::ORDER_DELIVERED) {
+            printf("[Orders] #%u %s delivered in %lu ms, %d attempt(s)\n", o.id, o.name.c_str(), (unsigned long)o.latencyMs, o.attempts);
+        } else {
+            printf("[Orders] #%u %s FAILED after %d attempt(s)\n", o.id, o.name.c_str(), o.attempts);
+        }
+        printf("[Orders] delivered %lu, failed %lu, refused %lu, retries %lu, latency avg %lu / max %lu ms, results dropped %lu\n",
+               (unsigned long)m.delivered, (unsigned long)m.failed, (unsigned long)m.rejected, (unsigned long)m.retries,
+               (unsigned long)m.avgLatencyMs(), (unsigned long)m.maxLatencyMs, (unsigned long)order_events.getDropped());
+    }
+
+    static void radioTask(void* arg) {
+        ESPNowManager* self = (ESPNowManager*)arg;
+        if (!self->begin()) {
+            printf("[ESP-NOW] WARNING: Init failed. Running in Offline/Mock mode.\n");
+            vTaskDelete(NULL);
+            return;
+        }
+        // Pages created before the radio was up could not send theirs (pumps went out with the probe)
+        self->requestRecipeSync();
+
+        // The controller may boot after us or follow its AP to another channel: keep looking
+        bool searched = false;
+        while (controller_rx == 0) {
+            delay(ESPNOW_RETRY_MS);
+            if (controller_rx != 0) break;
+            searched = true;
+            if (self->probe(ESPNOW_PROBE_TIMEOUT_MS)) {
+                self->saveChannel(WiFi.channel());
+                break;
+            }
+            self->searchController();
+        }
+        if (searched) {
+            printf("[ESP-NOW] Controller answered on channel %d\n", (int)WiFi.channel());
+            self->requestRecipeSync();
+        }
+        vTaskDelete(NULL);
+    }
+
+    volatile bool ready = false;
+    int32_t savedChannel = 0; // In Preferences, 0 = none
+    bool controllerPeer = false;
+    OrderQueue orders;
+    uint32_t onAirSince = 0;
+
+    PumpCalibrationEntry pendingPumps[4] = {};
+    uint8_t pendingMask = 0; // Bit per pump waiting in pendingPumps
+    unsigned long pendingSince = 0;
+
+    void setChannel(int32_t channel) {
+        esp_wifi_set_promiscuous(true);
+        esp_wifi_set_channel(channel, WIFI_SECOND_CHAN_NONE);
+        esp_wifi_set_promiscuous(false);
+    }
+
+    // Pump sync request as a ping: a reply from the controller means it hears us
+    bool probe(uint32_t timeoutMs) {
+        uint32_t before = controller_rx;
+        requestPumpSync();
+        unsigned long start = millis();
+        while (millis() - start < timeoutMs) {
+            if (controller_rx != before) return true;
+            delay(10);
+        }
+        return false;
+    }
+
+    // Moves the radio to the controller's channel and saves it, or back where it was. Runs on the radio task.
+    void searchController() {
+        int32_t current = WiFi.channel();
+        int32_t found = findController(current);
+        if (found > 0) {
+            saveChannel(found);
+        } else {
+            printf("[ESP-NOW] Controller not found. Staying on channel %d. (Check secrets.h)\n", (int)current);
+            setChannel(current);
+        }
+        printf("[ESP-NOW] Current Radio Channel: %d\n", (int)WiFi.channel());
+    }
+
+    // Sweep the other channels, then ask the AP scan as a last resort.
+    // The AP's channel is kept even when the probe there fails: the controller
+    // joins that AP, so it is where it will be once it is up.
+    int32_t findController(int32_t skip) {
+        for (int32_t ch = 1; ch <= ESPNOW_MAX_CHANNEL; ch++) {
+            if (ch == skip) continue;
+            setChannel(ch);
+            if (probe(ESPNOW_SWEEP_DWELL_MS)) {
+                printf("[ESP-NOW] Controller found on channel %d (sweep)\n", (int)ch);
+                return ch;
+            }
+        }
+
+        printf("[ESP-NOW] Searching for network: %s\n", TARGET_WIFI_SSID);
+        int32_t channel = getWiFiChannel(TARGET_WIFI_SSID);
+        if (channel > 0) {
+            printf("[ESP-NOW] Found network '%s' on channel %d. Switching radio...\n", TARGET_WIFI_SSID, (int)channel);
+            setChannel(channel);
+            if (!probe(ESPNOW_PROBE_TIMEOUT_MS)) {
+                printf("[ESP-NOW] No answer on channel %d yet, staying with the AP\n", (int)channel);
+            }
+            return channel;
+        }
+        return 0;
+    }
+
+    int32_t loadChannel() {
+        Preferences prefs;
+        if (!prefs.begin("radio", true)) return 0;
+        int32_t channel = prefs.getUChar("channel", 0);
+        prefs.end();
+        return (channel >= 1 && channel <= ESPNOW_MAX_CHANNEL) ? channel : 0;
+    }
+
+    void saveChannel(int32_t channel) {
+        if (channel == savedChannel) return;
+        Preferences prefs;
+        if (!prefs.begin("radio", false)) return;
+        prefs.putUChar("channel", (uint8_t)channel);
+        prefs.end();
+        savedChannel = channel;
+        printf("[ESP-NOW] Channel %d saved for next boot\n", (int)channel);
+    }
+
     int32_t getWiFiChannel(const char *ssid) {
         if (int32_t n = WiFi.scanNetworks()) {
             for (uint8_t i = 0; i < n; i++) {
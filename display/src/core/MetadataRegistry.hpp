@@ -0,0 +1,136 @@
+#ifndef METADATA_REGISTRY_HPP
+#define METADATA_REGISTRY_HPP
+
+#include <Arduino.h>
+#include "models.hpp"
+#include "remote_protocol.hpp"
+#include "../ui/assets/icons.h"
+
+#define METADATA_REGISTRY_CAPACITY 64 // Power of two, recipe names remembered
+
+/**
+ * @brief Recipe name -> icon/color and pump <-> ingredient name tables
+ *
+ * Lookups hash the name into a fixed table. Entries come from the
+ * controller (RecipeSyncData::iconId / color) through setRecipe(), or, for
+ * names it did not describe, from the keyword rules below, which run once
+ * per name and are then remembered.
+ */
+class MetadataRegistry {
+public:
+    struct RecipeMeta {
+        uint8_t iconId;
+        uint32_t color;
+    };
+
+    MetadataRegistry() {
+        static const char* DEFAULT_PUMPS[] = {"Cocacola", "Orange Juice", "Vodka", "Grenadine"};
+        for (int i = 0; i < 4; i++) pumpNames[i] = DEFAULT_PUMPS[i];
+    }
+
+    static const void* iconImage(uint8_t iconId) {
+        switch (iconId) {
+            case RECIPE_ICON_COCA_COLA:    return ICON_COCKTAIL_COCA_COLA;
+            case RECIPE_ICON_GIN_TONIC:    return ICON_COCKTAIL_GIN_TONIC;
+            case RECIPE_ICON_VODKA:        return ICON_COCKTAIL_VODKA;
+            case RECIPE_ICON_SEX_ON_BEACH: return ICON_COCKTAIL_SEX_ON_BEACH;
+            case RECIPE_ICON_PORN_STAR:    return ICON_COCKTAIL_PORN_STAR;
+            case RECIPE_ICON_RON:          return ICON_COCKTAIL_RON;
+            default:                       return ICON_COCKTAIL_VODKA;
+        }
+    }
+
+    static uint32_t defaultColor(uint8_t iconId) {
+        switch (iconId) {
+            case RECIPE_ICON_COCA_COLA:    return 0xFF0000;
+            case RECIPE_ICON_GIN_TONIC:    return 0xADD8E6;
+            case RECIPE_ICON_VODKA:        return 0x00FFFF;
+            case RECIPE_ICON_SEX_ON_BEACH: return 0xFF1493;
+            case RECIPE_ICON_PORN_STAR:    return 0xFF4500;
+            case RECIPE_ICON_RON:          return 0x8B4513;
+            default:                       return 0x888888;
+        }
+    }
+
+    // Controller supplied entry (RecipeSyncData), replaces what the name resolved to before
+    void setRecipe(const char* name, uint8_t iconId, uint32_t color) {
+        if (iconId >= RECIPE_ICON_COUNT) iconId = RECIPE_ICON_NONE;
+        RecipeMeta meta = {iconId, color ? color : defaultColor(iconId)};
+        Entry* e = slotFor(name);
+        if (e) {
+            e->name = name;
+            e->meta = meta;
+            e->used = true;
+        }
+    }
+
+    RecipeMeta resolve(const char* name) {
+        Entry* e = slotFor(name);
+        if (e && e->used) return e->meta;
+
+        RecipeMeta meta = matchRules(name);
+        if (e) {
+            e->name = name;
+            e->meta = meta;
+            e->used = true;
+        }
+        return meta;
+    }
+
+    // pump: 1..4
+    const char* pumpName(int pump) const {
+        return (pump >= 1 && pump <= 4) ? pumpNames[pump - 1].c_str() : "";
+    }
+
+    // 0 when no pump carries this ingredient
+    int pumpFor(const char* ingredient) const {
+        for (int i = 0; i < 4; i++) {
+            if (pumpNames[i] == ingredient) return i + 1;
+        }
+        return 0;
+    }
+
+private:
+    struct Entry {
+        FixedString<RECIPE_NAME_LEN> name;
+        RecipeMeta meta;
+        bool used = false;
+    };
+
+    struct Rule {
+        const char* keyword;
+        uint8_t iconId;
+        uint32_t color;
+    };
+
+    Entry table[METADATA_REGISTRY_CAPACITY];
+    FixedString<INGREDIENT_NAME_LEN> pumpNames[4];
+
+    // Matching entry or the free slot it belongs in; nullptr when the table is full
+    Entry* slotFor(const char* name) {
+        size_t mask = METADATA_REGISTRY_CAPACITY - 1;
+        size_t i = model_name_hash(name) & mask;
+        for (size_t n = 0; n < METADATA_REGISTRY_CAPACITY; n++, i = (i + 1) & mask) {
+            if (!table[i].used || table[i].name == name) return &table[i];
+        }
+        return nullptr;
+    }
+
+    // Names the controller did not describe (legacy controllers, mocks)
+    static RecipeMeta matchRules(const char* name) {
+        static const Rule RULES[] = {
+            {"Coca",    RECIPE_ICON_COCA_COLA,    0xFF0000},
+            {"Orange",  RECIPE_ICON_GIN_TONIC,    0xFFA500},
+            {"Vodka",   RECIPE_ICON_VODKA,        0x00FFFF},
+            {"Sex",     RECIPE_ICON_SEX_ON_BEACH, 0xFF1493},
+            {"Tequila", RECIPE_ICON_PORN_STAR,    0xFF4500},
+            {"Gin",     RECIPE_ICON_GIN_TONIC,    0xADD8E6},
+        };
+        for (const auto& r : RULES) {
+            if (strstr(name, r.keyword)) return {r.iconId, r.color};
+        }
+        return {RECIPE_ICON_VODKA, 0x888888};
+    }
+};
+
+#endif // METADATA_REGISTRY_HPP
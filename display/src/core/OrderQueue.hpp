@@ -0,0 +1,213 @@
+#ifndef ORDER_QUEUE_HPP
+#define ORDER_QUEUE_HPP
+
+#include <Arduino.h>
+#include <atomic>
+#include "models.hpp"
+#include "Config.hpp"
+
+/**
+ * @brief Bounded FIFO of drink orders waiting for the controller
+ *
+ * Only the head is on the air: the controller makes one drink at a time.
+ * Every attempt reschedules the head with exponential backoff; it leaves the
+ * queue when acknowledged, after ORDER_MAX_ATTEMPTS or after ORDER_TIMEOUT_MS
+ * in the queue.
+ *
+ * Orders sent with retryOnTimer are resent when the backoff runs out without
+ * an ACK (controllers that ignore ids they already took). The others are
+ * resent only after linkFailed(): a controller that cannot de-duplicate must
+ * not get the same order twice because its ACK was slow.
+ *
+ * Radio agnostic and owned by the LVGL task; times are passed in (millis).
+ */
+class OrderQueue {
+public:
+    enum State : uint8_t {
+        ORDER_WAITING,   // Not sent yet (controller unknown or another order ahead)
+        ORDER_SENT,      // On the air, waiting for the ACK
+        ORDER_DELIVERED,
+        ORDER_FAILED
+    };
+
+    struct Order {
+        uint16_t id = 0;
+        FixedString<RECIPE_NAME_LEN> name;
+        State state = ORDER_WAITING;
+        uint8_t attempts = 0;
+        bool retryOnTimer = false; // Resend when retryAt passes without an ACK
+        bool linkLost = false;     // The link reported the last attempt lost
+        uint32_t queuedAt = 0;
+        uint32_t sentAt = 0;    // First attempt
+        uint32_t retryAt = 0;   // Next attempt, valid while ORDER_SENT
+        uint32_t latencyMs = 0; // First attempt -> acknowledged, once delivered
+    };
+
+    struct Metrics {
+        uint32_t delivered = 0;
+        uint32_t failed = 0;
+        uint32_t rejected = 0; // push() with a full queue
+        uint32_t retries = 0;  // Attempts beyond the first
+        uint32_t lastLatencyMs = 0;
+        uint32_t maxLatencyMs = 0;
+        uint32_t totalLatencyMs = 0;
+
+        uint32_t avgLatencyMs() const { return delivered ? totalLatencyMs / delivered : 0; }
+    };
+
+    // Order id, 0 when the queue is full
+    uint16_t push(const char* name, uint32_t now) {
+        if (count >= ORDER_QUEUE_LEN) {
+            metrics.rejected++;
+            return 0;
+        }
+        if (++nextId == 0) nextId = 1; // 0 = no order
+        Order& o = items[(head + count) % ORDER_QUEUE_LEN];
+        o = Order();
+        o.id = nextId;
+        o.name = name;
+        o.queuedAt = now;
+        count++;
+        return o.id;
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count >= ORDER_QUEUE_LEN; }
+
+    // 0 = oldest (the one on the air)
+    const Order& operator[](size_t i) const { return items[(head + i) % ORDER_QUEUE_LEN]; }
+
+    // Head, when its next attempt is due; fails it first if it ran out of time or attempts
+    Order* due(uint32_t now) {
+        while (count > 0) {
+            Order& o = items[head];
+            bool expired = now - o.queuedAt >= ORDER_TIMEOUT_MS;
+            bool exhausted = retryDue(o, now) && o.attempts >= ORDER_MAX_ATTEMPTS;
+            if (!expired && !exhausted) break;
+            finish(o, ORDER_FAILED, now);
+        }
+        if (count == 0) return nullptr;
+        Order& o = items[head];
+        if (o.state == ORDER_WAITING || retryDue(o, now)) return &o;
+        return nullptr;
+    }
+
+    // Head went on the air: schedule the retry
+    void markSent(Order& o, uint32_t now, bool retryOnTimer) {
+        if (o.attempts > 0) metrics.retries++;
+        else o.sentAt = now;
+        o.attempts++;
+        o.state = ORDER_SENT;
+        o.retryOnTimer = retryOnTimer;
+        o.linkLost = false;
+        o.retryAt = now + backoffMs(o.attempts);
+    }
+
+    // The link lost this attempt: resend once the backoff runs out. false for stale ids.
+    bool linkFailed(uint16_t id) {
+        if (count == 0 || items[head].id != id || items[head].state != ORDER_SENT) return false;
+        items[head].linkLost = true;
+        return true;
+    }
+
+    // false for stale / duplicate ACKs
+    bool acknowledge(uint16_t id, uint32_t now) {
+        if (count == 0 || items[head].id != id || items[head].state != ORDER_SENT) return false;
+        finish(items[head], ORDER_DELIVERED, now);
+        return true;
+    }
+
+    uint16_t inFlight() const {
+        return (count > 0 && items[head].state == ORDER_SENT) ? items[head].id : 0;
+    }
+
+    // Most recent order that left the queue (id 0 = none yet), for the UI
+    const Order& lastFinished() const { return finished; }
+    const Metrics& getMetrics() const { return metrics; }
+
+    static uint32_t backoffMs(uint8_t attempts) {
+        uint32_t ms = ORDER_RETRY_BASE_MS;
+        for (uint8_t i = 1; i < attempts && ms < ORDER_RETRY_MAX_MS; i++) ms <<= 1;
+        return ms < ORDER_RETRY_MAX_MS ? ms : ORDER_RETRY_MAX_MS;
+    }
+
+private:
+    Order items[ORDER_QUEUE_LEN];
+    size_t head = 0;
+    size_t count = 0;
+    uint16_t nextId = 0;
+    Order finished;
+    Metrics metrics;
+
+    static bool retryDue(const Order& o, uint32_t now) {
+        return o.state == ORDER_SENT && (o.retryOnTimer || o.linkLost) && (int32_t)(now - o.retryAt) >= 0;
+    }
+
+    void finish(Order& o, State state, uint32_t now) {
+        o.state = state;
+        if (state == ORDER_DELIVERED) {
+            o.latencyMs = now - o.sentAt;
+            metrics.delivered++;
+            metrics.lastLatencyMs = o.latencyMs;
+            metrics.totalLatencyMs += o.latencyMs;
+            if (o.latencyMs > metrics.maxLatencyMs) metrics.maxLatencyMs = o.latencyMs;
+        } else {
+            metrics.failed++;
+        }
+        finished = o;
+        head = (head + 1) % ORDER_QUEUE_LEN;
+        count--;
+    }
+};
+
+/**
+ * @brief Order results from the radio callbacks to the UI loop, tagged with the order id
+ *
+ * Single producer (the Wi-Fi task runs both ESP-NOW callbacks), single
+ * consumer (OrderQueue's owner). When full, new results are dropped and
+ * counted; the order then falls back to its timeout.
+ */
+class OrderEventRing {
+public:
+    enum Kind : uint8_t {
+        ORDER_EVENT_LINK_OK,   // Link-layer ACK for the frame carrying the order
+        ORDER_EVENT_LINK_LOST, // No link-layer ACK after the radio's own retries
+        ORDER_EVENT_ACK        // REMOTE_CMD_ORDER_ACK from the controller
+    };
+
+    struct Event {
+        uint16_t id;
+        Kind kind;
+    };
+
+    bool push(uint16_t id, Kind kind) {
+        uint8_t h = head.load(std::memory_order_relaxed);
+        uint8_t next = (h + 1) % ORDER_EVENT_RING;
+        if (next == tail.load(std::memory_order_acquire)) {
+            dropped++;
+            return false;
+        }
+        events[h] = {id, kind};
+        head.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(Event& e) {
+        uint8_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) return false;
+        e = events[t];
+        tail.store((t + 1) % ORDER_EVENT_RING, std::memory_order_release);
+        return true;
+    }
+
+    uint32_t getDropped() const { return dropped; }
+
+private:
+    Event events[ORDER_EVENT_RING];
+    std::atomic<uint8_t> head{0};
+    std::atomic<uint8_t> tail{0};
+    volatile uint32_t dropped = 0;
+};
+
+#endif // ORDER_QUEUE_HPP
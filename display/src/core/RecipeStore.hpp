@@ -0,0 +1,211 @@
+#ifndef RECIPE_STORE_HPP
+#define RECIPE_STORE_HPP
+
+#include <Arduino.h>
+#include <vector>
+#include "models.hpp"
+
+/**
+ * @brief Stable reference to a recipe in a RecipeStore
+ *
+ * Slot index + generation. A handle whose recipe was removed resolves to
+ * nullptr instead of to whatever took the slot later. Fits in 32 bits so
+ * it can travel as LVGL event user data (toUserData / fromUserData).
+ */
+struct RecipeHandle {
+    uint16_t slot = 0;
+    uint16_t generation = 0; // 0 = no recipe
+
+    bool isValid() const { return generation != 0; }
+    bool operator==(const RecipeHandle& o) const { return slot == o.slot && generation == o.generation; }
+
+    void* toUserData() const { return (void*)(uintptr_t)(((uint32_t)generation << 16) | slot); }
+    static RecipeHandle fromUserData(const void* p) {
+        uint32_t v = (uint32_t)(uintptr_t)p;
+        RecipeHandle h;
+        h.slot = (uint16_t)(v & 0xFFFF);
+        h.generation = (uint16_t)(v >> 16);
+        return h;
+    }
+};
+
+/**
+ * @brief Slot map of recipes with O(1) lookup by handle and by name
+ *
+ * Recipes live in slots that are reused through a free list; the display
+ * order is kept separately. Names are unique: upsert() of an existing name
+ * updates that recipe in place and keeps its handle, so a re-sync of an
+ * unchanged catalogue leaves every card's handle valid.
+ *
+ * Sync sessions: beginSession() empties the display order, each upsert()
+ * puts its recipe back in arrival order, endSession() removes the recipes
+ * that did not come back.
+ */
+class RecipeStore {
+public:
+    explicit RecipeStore(size_t capacity) {
+        slots.reserve(capacity);
+        order.reserve(capacity);
+        rebuildIndex(capacity * 2);
+    }
+
+    // Copies keep the source's capacity: a snapshot copied from the working
+    // store can later take a bigger catalogue without reallocating
+    RecipeStore(const RecipeStore& o) { *this = o; }
+    RecipeStore& operator=(const RecipeStore& o) {
+        if (this == &o) return *this;
+        slots.reserve(o.slots.capacity());
+        order.reserve(o.order.capacity());
+        slots = o.slots;
+        order = o.order;
+        index = o.index;
+        freeHead = o.freeHead;
+        live = o.live;
+        return *this;
+    }
+
+    // --- Ordered access (display order) ---
+    size_t size() const { return order.size(); }
+    bool empty() const { return order.empty(); }
+    const ICocktail& operator[](size_t i) const { return slots[order[i].slot].value; }
+    RecipeHandle handleAt(size_t i) const { return order[i]; }
+
+    // --- Lookup ---
+    ICocktail* get(RecipeHandle h) {
+        if (h.slot >= slots.size() || !h.isValid()) return nullptr;
+        Slot& s = slots[h.slot];
+        return (s.generation == h.generation && s.used) ? &s.value : nullptr;
+    }
+    const ICocktail* get(RecipeHandle h) const { return const_cast<RecipeStore*>(this)->get(h); }
+
+    RecipeHandle find(const char* name) const {
+        size_t mask = index.size() - 1;
+        for (size_t i = model_name_hash(name) & mask; index[i] != 0; i = (i + 1) & mask) {
+            const Slot& s = slots[index[i] - 1];
+            if (s.value.name == name) return handleOf(index[i] - 1);
+        }
+        return RecipeHandle();
+    }
+
+    // --- Mutation ---
+    RecipeHandle upsert(const ICocktail& c) {
+        RecipeHandle h = find(c.name.c_str());
+        if (h.isValid()) {
+            Slot& s = slots[h.slot];
+            s.value = c;
+            if (!s.listed) {
+                s.listed = true;
+                order.push_back(h);
+            }
+            return h;
+        }
+
+        uint16_t slot;
+        if (freeHead != NO_SLOT) {
+            slot = freeHead;
+            freeHead = slots[slot].nextFree;
+        } else {
+            slot = (uint16_t)slots.size();
+            slots.emplace_back();
+        }
+        Slot& s = slots[slot];
+        s.value = c;
+        s.used = true;
+        s.listed = true;
+        live++;
+        h = handleOf(slot);
+        order.push_back(h);
+
+        if (live * 2 > index.size()) rebuildIndex(index.size() * 2);
+        else insertIndex(slot);
+        return h;
+    }
+
+    bool erase(RecipeHandle h) {
+        if (!get(h)) return false;
+        release(h.slot);
+        rebuildIndex(index.size());
+        return true;
+    }
+
+    void clear() {
+        for (size_t i = 0; i < slots.size(); i++) {
+            if (slots[i].used) release((uint16_t)i);
+        }
+        rebuildIndex(index.size());
+    }
+
+    void beginSession() {
+        order.clear();
+        for (auto& s : slots) s.listed = false;
+    }
+
+    void endSession() {
+        bool removed = false;
+        for (size_t i = 0; i < slots.size(); i++) {
+            if (slots[i].used && !slots[i].listed) {
+                release((uint16_t)i);
+                removed = true;
+            }
+        }
+        if (removed) rebuildIndex(index.size());
+    }
+
+private:
+    static constexpr uint16_t NO_SLOT = 0xFFFF;
+
+    struct Slot {
+        ICocktail value;
+        uint16_t generation = 1;
+        uint16_t nextFree = NO_SLOT;
+        bool used = false;
+        bool listed = false; // present in order
+    };
+
+    std::vector<Slot> slots;
+    std::vector<RecipeHandle> order;
+    std::vector<uint16_t> index; // open addressing by name, slot + 1 (0 = empty), power of two
+    uint16_t freeHead = NO_SLOT;
+    size_t live = 0;
+
+    RecipeHandle handleOf(uint16_t slot) const {
+        RecipeHandle h;
+        h.slot = slot;
+        h.generation = slots[slot].generation;
+        return h;
+    }
+
+    // Frees the slot; callers rebuild the name index afterwards
+    void release(uint16_t slot) {
+        Slot& s = slots[slot];
+        if (s.listed) {
+            for (size_t i = 0; i < order.size(); i++) {
+                if (order[i].slot == slot) { order.erase(order.begin() + i); break; }
+            }
+        }
+        s.used = false;
+        s.listed = false;
+        if (++s.generation == 0) s.generation = 1; // 0 is reserved for "no recipe"
+        s.nextFree = freeHead;
+        freeHead = slot;
+        live--;
+    }
+
+    void insertIndex(uint16_t slot) {
+        size_t mask = index.size() - 1;
+        size_t i = model_name_hash(slots[slot].value.name.c_str()) & mask;
+        while (index[i] != 0) i = (i + 1) & mask;
+        index[i] = slot + 1;
+    }
+
+    void rebuildIndex(size_t minSize) {
+        size_t n = 8;
+        while (n < minSize) n <<= 1;
+        index.assign(n, 0);
+        for (size_t i = 0; i < slots.size(); i++) {
+            if (slots[i].used) insertIndex((uint16_t)i);
+        }
+    }
+};
+
+#endif // RECIPE_STORE_HPP
@@ -2,25 +2,119 @@
 #define MODELS_HPP
 
 #include <Arduino.h>
-#include <vector>
+#include <initializer_list>
+#include <string.h>
+
+#define RECIPE_NAME_LEN 32     // Same as RecipeSyncData::name
+#define INGREDIENT_NAME_LEN 16
+#define MAX_INGREDIENTS 4      // One per pump
+
+// 32-bit FNV-1a, for the name indexes (RecipeStore, MetadataRegistry)
+inline uint32_t model_name_hash(const char* s) {
+    uint32_t h = 2166136261u;
+    while (*s) {
+        h ^= (uint8_t)*s++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief String stored inline: up to N chars, never allocates
+ *
+ * Longer input is truncated. Only the String methods the UI and
+ * DataManager actually use are provided.
+ */
+template <size_t N>
+class FixedString {
+public:
+    FixedString() { buf[0] = '\0'; }
+    FixedString(const char* s) { assign(s); }
+
+    FixedString& operator=(const char* s) { assign(s); return *this; }
+
+    void assign(const char* s) {
+        size_t n = 0;
+        if (s) {
+            while (n < N && s[n]) n++;
+            memcpy(buf, s, n);
+        }
+        buf[n] = '\0';
+    }
+
+    const char* c_str() const { return buf; }
+    size_t length() const { return strlen(buf); }
+    bool isEmpty() const { return buf[0] == '\0'; }
+    static constexpr size_t capacity() { return N; }
+
+    int indexOf(const char* s) const {
+        const char* p = strstr(buf, s);
+        return p ? (int)(p - buf) : -1;
+    }
+
+    bool operator==(const char* s) const { return strcmp(buf, s) == 0; }
+    template <size_t M>
+    bool operator==(const FixedString<M>& o) const { return strcmp(buf, o.c_str()) == 0; }
+    template <size_t M>
+    bool operator!=(const FixedString<M>& o) const { return !(*this == o); }
+
+private:
+    char buf[N + 1];
+};
 
 /**
  * @brief Unified interface for a drink ingredient
  */
 struct IIngredient {
-    String name;
+    FixedString<INGREDIENT_NAME_LEN> name;
     int pump;
     int quantity;
 };
 
+/**
+ * @brief Ingredients of one recipe, inline (no heap)
+ */
+class IngredientList {
+public:
+    IngredientList() {}
+    IngredientList(std::initializer_list<IIngredient> init) {
+        for (const auto& i : init) push_back(i);
+    }
+
+    // false when full (MAX_INGREDIENTS)
+    bool push_back(const IIngredient& i) {
+        if (count >= MAX_INGREDIENTS) return false;
+        items[count++] = i;
+        return true;
+    }
+
+    void clear() { count = 0; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    IIngredient& operator[](size_t i) { return items[i]; }
+    const IIngredient& operator[](size_t i) const { return items[i]; }
+
+    IIngredient* begin() { return items; }
+    IIngredient* end() { return items + count; }
+    const IIngredient* begin() const { return items; }
+    const IIngredient* end() const { return items + count; }
+
+private:
+    IIngredient items[MAX_INGREDIENTS];
+    uint8_t count = 0;
+};
+
 /**
  * @brief Unified interface for a cocktail recipe
+ *
+ * Plain data: copying one (e.g. into the edit modal) is a memcpy.
  */
 struct ICocktail {
-    String name;
+    FixedString<RECIPE_NAME_LEN> name;
     const void * icon; // Reference to LVGL image source
     uint32_t color;    // Representative color (HEX)
-    std::vector<IIngredient> ingredients;
+    IngredientList ingredients;
 };
 
 /**
@@ -0,0 +1,271 @@
+#ifndef REMOTE_FRAME_HPP
+#define REMOTE_FRAME_HPP
+
+#include <Arduino.h>
+#include "remote_protocol.hpp"
+
+// --- Compact frames ---
+// Legacy frames are the raw struct_message, always sizeof(struct_message) bytes.
+// Compact frames carry only what a command uses:
+//
+//   [REMOTE_FRAME_MAGIC] [version] [varint id] { [tag] [varint length] [value] }*
+//
+// Integers are LEB128 varints (zigzag for signed), unknown tags are skipped,
+// a higher version is rejected. Calibration travels as whole ms.
+//
+// Negotiation: a peer switches to compact frames only after it received one.
+// Sync requests (100 / 102) sent as legacy frames put REMOTE_FRAME_VERSION in
+// `temp` to announce that compact replies are understood; older controllers
+// ignore the field and keep using legacy frames.
+
+#define REMOTE_FRAME_MAGIC 0xC5
+#define REMOTE_FRAME_VERSION 1
+#define REMOTE_FRAME_MAX (sizeof(struct_message)) // never larger than a legacy frame
+
+enum RemoteFrameTag {
+    REMOTE_TAG_ID_READING = 1, // zigzag varint
+    REMOTE_TAG_TEMP = 2,       // 4 bytes float
+    REMOTE_TAG_TEXT = 3,       // choose[] without terminator
+    REMOTE_TAG_PUMPS = 4,      // 4 x (zigzag pwm, varint ms)
+    REMOTE_TAG_RECIPE = 5,     // index, total, name length + name, 4 x varint ml, iconId, varint color
+    REMOTE_TAG_CALIBRATION = 6 // count, count x (pump, varint pwm, varint ms)
+};
+
+struct RemoteFrameWriter {
+    uint8_t* buf;
+    size_t cap;
+    size_t len;
+    bool ok;
+
+    void byte(uint8_t b) {
+        if (len < cap) buf[len++] = b;
+        else ok = false;
+    }
+
+    void varint(uint32_t v) {
+        while (v >= 0x80) {
+            byte((uint8_t)(v | 0x80));
+            v >>= 7;
+        }
+        byte((uint8_t)v);
+    }
+
+    void zigzag(int32_t v) { varint(((uint32_t)v << 1) ^ (uint32_t)(v >> 31)); }
+
+    void bytes(const void* p, size_t n) {
+        for (size_t i = 0; i < n; i++) byte(((const uint8_t*)p)[i]);
+    }
+
+    // Tag + length prefix; the value is written by the caller into a scratch writer
+    void field(uint8_t tag, const RemoteFrameWriter& value) {
+        byte(tag);
+        varint((uint32_t)value.len);
+        bytes(value.buf, value.len);
+        ok = ok && value.ok;
+    }
+};
+
+struct RemoteFrameReader {
+    const uint8_t* buf;
+    size_t len;
+    size_t pos;
+    bool ok;
+
+    uint8_t byte() {
+        if (pos < len) return buf[pos++];
+        ok = false;
+        return 0;
+    }
+
+    uint32_t varint() {
+        uint32_t v = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            uint8_t b = byte();
+            v |= (uint32_t)(b & 0x7F) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        ok = false;
+        return 0;
+    }
+
+    int32_t zigzag() {
+        uint32_t v = varint();
+        return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+    }
+
+    void bytes(void* p, size_t n) {
+        for (size_t i = 0; i < n; i++) ((uint8_t*)p)[i] = byte();
+    }
+};
+
+inline size_t remote_text_len(const char* s, size_t cap) {
+    size_t n = 0;
+    while (n < cap && s[n]) n++;
+    return n;
+}
+
+/**
+ * Encodes msg as a compact frame. Returns the frame length, or 0 for commands
+ * without a compact form (send those as legacy frames).
+ */
+inline size_t remote_frame_encode(const struct_message& msg, uint8_t* out, size_t cap) {
+    RemoteFrameWriter w = {out, cap, 0, true};
+    uint8_t scratch[128];
+    RemoteFrameWriter v = {scratch, sizeof(scratch), 0, true};
+
+    w.byte(REMOTE_FRAME_MAGIC);
+    w.byte(REMOTE_FRAME_VERSION);
+    w.varint((uint32_t)msg.id);
+
+    if (msg.temp != 0.0f) {
+        float temp = msg.temp;
+        v.len = 0;
+        v.bytes(&temp, sizeof(temp));
+        w.field(REMOTE_TAG_TEMP, v);
+    }
+    if (msg.idReading != 0) {
+        v.len = 0;
+        v.zigzag(msg.idReading);
+        w.field(REMOTE_TAG_ID_READING, v);
+    }
+
+    switch (msg.id) {
+        case REMOTE_CMD_SYNC_REQUEST:
+        case REMOTE_CMD_RECIPE_SYNC_REQUEST:
+        case REMOTE_CMD_SYNC_UNCHANGED:
+        case REMOTE_CMD_ORDER_ACK:
+            break;
+
+        case REMOTE_CMD_DRINK_ORDER:
+        case REMOTE_CMD_PUMP_UPDATE: {
+            v.len = 0;
+            v.bytes(msg.choose, remote_text_len(msg.choose, sizeof(msg.choose)));
+            w.field(REMOTE_TAG_TEXT, v);
+            break;
+        }
+
+        case REMOTE_CMD_SYNC_RESPONSE: {
+            v.len = 0;
+            for (int i = 0; i < 4; i++) {
+                v.zigzag(msg.pumpValues.pwm[i]);
+                v.varint((uint32_t)(msg.pumpValues.calibration[i] * 1000.0f + 0.5f));
+            }
+            w.field(REMOTE_TAG_PUMPS, v);
+            break;
+        }
+
+        case REMOTE_CMD_PUMP_CALIBRATION: {
+            PumpCalibrationData c = msg.pumpCalibration;
+            if (c.count > 4) return 0;
+            v.len = 0;
+            v.byte(c.count);
+            for (int i = 0; i < c.count; i++) {
+                v.byte(c.pumps[i].pump);
+                v.varint(c.pumps[i].pwm);
+                v.varint(c.pumps[i].timeMs);
+            }
+            w.field(REMOTE_TAG_CALIBRATION, v);
+            break;
+        }
+
+        case REMOTE_CMD_RECIPE_DATA:
+        case REMOTE_CMD_RECIPE_UPDATE: {
+            RecipeSyncData r = msg.recipeData; // copy: struct_message is packed
+            size_t n = remote_text_len(r.name, sizeof(r.name));
+            v.len = 0;
+            v.byte(r.index);
+            v.byte(r.total);
+            v.byte((uint8_t)n);
+            v.bytes(r.name, n);
+            for (int i = 0; i < 4; i++) v.varint(r.ingredientsMl[i]);
+            v.byte(r.iconId);
+            v.varint(r.color);
+            w.field(REMOTE_TAG_RECIPE, v);
+            break;
+        }
+
+        default:
+            return 0; // joystick / gyro: legacy only
+    }
+    return w.ok ? w.len : 0;
+}
+
+/**
+ * Decodes a legacy or compact frame into a zeroed struct_message.
+ * *compact tells which one it was.
+ */
+inline bool remote_frame_decode(const uint8_t* data, size_t len, struct_message& msg, bool* compact = nullptr) {
+    memset(&msg, 0, sizeof(msg));
+    if (compact) *compact = false;
+
+    if (len == sizeof(struct_message)) {
+        memcpy(&msg, data, sizeof(msg));
+        return true;
+    }
+    if (len < 3 || data[0] != REMOTE_FRAME_MAGIC || data[1] > REMOTE_FRAME_VERSION) return false;
+
+    RemoteFrameReader r = {data, len, 2, true};
+    msg.id = (int)r.varint();
+    while (r.ok && r.pos < r.len) {
+        uint8_t tag = r.byte();
+        uint32_t n = r.varint();
+        if (!r.ok || n > r.len - r.pos) return false;
+        RemoteFrameReader v = {data + r.pos, n, 0, true};
+        r.pos += n;
+
+        switch (tag) {
+            case REMOTE_TAG_ID_READING:
+                msg.idReading = v.zigzag();
+                break;
+            case REMOTE_TAG_TEMP: {
+                float temp = 0;
+                v.bytes(&temp, sizeof(temp));
+                msg.temp = temp;
+                break;
+            }
+            case REMOTE_TAG_TEXT:
+                if (n >= sizeof(msg.choose)) return false;
+                v.bytes(msg.choose, n);
+                break;
+            case REMOTE_TAG_PUMPS:
+                for (int i = 0; i < 4; i++) {
+                    msg.pumpValues.pwm[i] = v.zigzag();
+                    msg.pumpValues.calibration[i] = v.varint() / 1000.0f;
+                }
+                break;
+            case REMOTE_TAG_RECIPE: {
+                RecipeSyncData d = {};
+                d.index = v.byte();
+                d.total = v.byte();
+                uint8_t nameLen = v.byte();
+                if (nameLen > sizeof(d.name)) return false;
+                v.bytes(d.name, nameLen);
+                for (int i = 0; i < 4; i++) d.ingredientsMl[i] = (uint16_t)v.varint();
+                d.iconId = v.byte();
+                d.color = v.varint();
+                msg.recipeData = d;
+                break;
+            }
+            case REMOTE_TAG_CALIBRATION: {
+                PumpCalibrationData c = {};
+                c.count = v.byte();
+                if (c.count > 4) return false;
+                for (int i = 0; i < c.count; i++) {
+                    c.pumps[i].pump = v.byte();
+                    c.pumps[i].pwm = (uint16_t)v.varint();
+                    c.pumps[i].timeMs = (uint16_t)v.varint();
+                }
+                msg.pumpCalibration = c;
+                break;
+            }
+            default:
+                break; // newer field, skipped
+        }
+        if (!v.ok) return false;
+    }
+    if (!r.ok) return false;
+    if (compact) *compact = true;
+    return true;
+}
+
+#endif // REMOTE_FRAME_HPP
@@ -21,11 +21,39 @@ struct PumpSyncData {
     float calibration[4];
 };
 
+// Binary pump update (ID 107), one entry per changed pump
+struct PumpCalibrationEntry {
+    uint8_t pump;     // 1..4
+    uint8_t reserved;
+    uint16_t pwm;
+    uint16_t timeMs;
+};
+
+struct PumpCalibrationData {
+    uint8_t count;    // Valid entries
+    PumpCalibrationEntry pumps[4];
+};
+
+// Icon ids carried in RecipeSyncData::iconId
+enum RecipeIconId {
+    RECIPE_ICON_NONE = 0, // Display resolves from the name
+    RECIPE_ICON_COCA_COLA = 1,
+    RECIPE_ICON_GIN_TONIC = 2,
+    RECIPE_ICON_VODKA = 3,
+    RECIPE_ICON_SEX_ON_BEACH = 4,
+    RECIPE_ICON_PORN_STAR = 5,
+    RECIPE_ICON_RON = 6,
+    RECIPE_ICON_COUNT
+};
+
 struct RecipeSyncData {
     uint8_t index;
     uint8_t total;
     char name[32];
     uint16_t ingredientsMl[4]; // [0]=Pump1, [1]=Pump2...
+    // Optional presentation, zero from controllers that predate it (still fits the union)
+    uint8_t iconId;            // RecipeIconId
+    uint32_t color;            // 0xRRGGBB, 0 = default for the icon
 };
 
 enum ActionType {
@@ -36,6 +64,9 @@ enum ActionType {
     REMOTE_CMD_RECIPE_DATA = 103,
     REMOTE_CMD_PUMP_UPDATE = 104,
     REMOTE_CMD_RECIPE_UPDATE = 105,
+    REMOTE_CMD_SYNC_UNCHANGED = 106, // Reply to 100/102: idReading = request ID, display cache still valid
+    REMOTE_CMD_PUMP_CALIBRATION = 107, // Binary form of 104, only sent to controllers that send compact frames
+    REMOTE_CMD_ORDER_ACK = 108,      // Controller took drink order idReading (see below)
      // Legacy/Other inputs
     REMOTE_CMD_JOYSTICK = 1,
     REMOTE_CMD_GYRO = 2
@@ -52,9 +83,57 @@ typedef struct __attribute__((packed)) struct_message {
         };
         PumpSyncData pumpValues;   // Used for ID 101 (Sync Response)
         RecipeSyncData recipeData; // Used for ID 103 (Recipe Data)
+        PumpCalibrationData pumpCalibration; // Used for ID 107 (Pump Calibration)
     };
     ValuesGiroscope giroscopeValues;
     JoystickData joystickValues;
 } struct_message;
 
+// --- Drink orders ---
+// 99 carries an order id in idReading (1..65535, 0 from older displays) and is
+// unicast to the controller once it has been heard. Controllers that send
+// compact frames answer REMOTE_CMD_ORDER_ACK with the same idReading and must
+// ignore an id they already took: the display resends until acknowledged.
+// Older controllers are never resent to unless the link layer lost the frame.
+
+// --- Catalogue hashes ---
+// Sync requests (100 / 102) carry the hash of the display's cached copy in idReading (0 = nothing cached).
+// A controller computing the same value may answer REMOTE_CMD_SYNC_UNCHANGED instead of resending,
+// older controllers ignore the field and resend everything.
+// 32-bit FNV-1a over little endian integers, names up to their terminator.
+
+inline uint32_t remote_hash_u32(uint32_t h, uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+        h ^= (uint8_t)(v >> (i * 8));
+        h *= 16777619UL;
+    }
+    return h;
+}
+
+inline uint32_t remote_recipes_hash(const RecipeSyncData* recipes, size_t count) {
+    uint32_t h = remote_hash_u32(2166136261UL, (uint32_t)count);
+    for (size_t r = 0; r < count; r++) {
+        const RecipeSyncData& d = recipes[r];
+        for (size_t i = 0; i < sizeof(d.name) && d.name[i]; i++) {
+            h ^= (uint8_t)d.name[i];
+            h *= 16777619UL;
+        }
+        for (int i = 0; i < 4; i++) {
+            h = remote_hash_u32(h, d.ingredientsMl[i]);
+        }
+        h = remote_hash_u32(h, d.iconId);
+        h = remote_hash_u32(h, d.color);
+    }
+    return h;
+}
+
+inline uint32_t remote_pumps_hash(const PumpSyncData& p) {
+    uint32_t h = 2166136261UL;
+    for (int i = 0; i < 4; i++) {
+        h = remote_hash_u32(h, (uint32_t)p.pwm[i]);
+        h = remote_hash_u32(h, (uint32_t)(int32_t)(p.calibration[i] * 1000.0f + 0.5f)); // whole ms
+    }
+    return h;
+}
+
 #endif // REMOTE_PROTOCOL_HPP
@@ -63,12 +63,10 @@ inline void ingredient_context_cleanup(lv_event_t * e) {
 }
 
 // Create the dynamic modal
-inline void create_recipe_modal(lv_obj_t * parent, ICocktail * cocktail, RecipeSaveCallback on_save) {
+inline void create_recipe_modal(lv_obj_t * parent, const ICocktail * cocktail, RecipeSaveCallback on_save) {
     if (!cocktail) return;
     
-    // Create a safe copy of the data. 
-    // This prevents crashes if DataManager updates/clears the original vector 
-    // while we are editing (pointer invalidation).
+    // Edit buffer: slider moves stay local until released, then go out through on_save
     g_edit_copy = *cocktail; 
     g_save_cb = on_save;
 
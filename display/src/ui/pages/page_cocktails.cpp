@@ -12,7 +12,8 @@ static lv_obj_t* grid_cocktails_cont = NULL;
 static lv_timer_t* cocktails_refresh_timer = NULL;
 static lv_timer_t* sync_retry_timer = NULL;
 static lv_timer_t* status_timer = NULL;
-static unsigned long last_processed_update = 0;
+static lv_timer_t* orders_timer = NULL;
+static uint32_t last_processed_update = 0;
 
 #include "../components/modal/MyModal.hpp"
 
@@ -39,6 +40,11 @@ static void drink_event_cb(lv_event_t * e) {
     
     if (label) {
         const char * drink_name = lv_label_get_text(label);
+
+        if (ESPNowManager::getInstance().getOrders().full()) {
+            printf("[UI] Order queue full, not opening the modal for %s\n", drink_name);
+            return;
+        }
         
         // Copy to static buffer to ensure it persists comfortably
         strncpy(selected_drink, drink_name, sizeof(selected_drink) - 1);
@@ -55,11 +61,12 @@ static void drink_event_cb(lv_event_t * e) {
     }
 }
 
-static void refresh_grid() {
+// One snapshot for the whole grid: every card comes from the same catalogue
+static void refresh_grid(const CatalogSnapshot & snap) {
     if (!grid_cocktails_cont) return;
     lv_obj_clean(grid_cocktails_cont);
 
-    const auto& recipes = DataManager::getInstance().getRecipes();
+    const RecipeStore & recipes = snap.recipes;
     for(size_t i=0; i < recipes.size(); i++) {
         const auto& r = recipes[i];
         create_custom_card(grid_cocktails_cont, r.icon, r.name.c_str(), 220, 135, lv_color_hex(r.color), drink_event_cb, &lv_font_montserrat_20);
@@ -67,10 +74,11 @@ static void refresh_grid() {
 }
 
 static void refresh_timer_cb(lv_timer_t * t) {
-    if (DataManager::getInstance().getLastUpdate() > last_processed_update) {
+    const CatalogSnapshot & snap = DataManager::getInstance().snapshot();
+    if (snap.version > last_processed_update) {
         printf("[Cocktails] Data update detected. Refreshing...\n");
-        last_processed_update = DataManager::getInstance().getLastUpdate();
-        refresh_grid();
+        last_processed_update = snap.version;
+        refresh_grid(snap);
     }
 }
 
@@ -78,8 +86,9 @@ static void refresh_timer_cb(lv_timer_t * t) {
 
 static void sync_retry_timer_cb(lv_timer_t * t) {
     // If we are still using mocks, keep asking for real data
-    if (DataManager::getInstance().isUsingMocks()) {
-        printf("[Cocktails] Still using mocks. Retrying Sync Request...\n");
+    const CatalogSnapshot & snap = DataManager::getInstance().snapshot();
+    if (snap.usingMocks || snap.usingCache) {
+        printf("[Cocktails] Still on mocks/cache. Retrying Sync Request...\n");
         ESPNowManager::getInstance().requestRecipeSync();
         ESPNowManager::getInstance().requestPumpSync();
     } else {
@@ -96,7 +105,11 @@ static void status_timer_cb(lv_timer_t * t) {
 
     // Logic Update: Priority is Data Source, not just Link Heartbeat.
     // If we have real data (!usingMocks), we are effectively "Online" for the user.
-    if (!DataManager::getInstance().isUsingMocks()) {
+    const CatalogSnapshot & snap = DataManager::getInstance().snapshot();
+    if (snap.usingCache) {
+        lv_label_set_text(icon, LV_SYMBOL_REFRESH " Cached");
+        lv_obj_set_style_text_color(icon, lv_color_hex(0xFFFF00), 0);
+    } else if (!snap.usingMocks) {
         lv_label_set_text(icon, LV_SYMBOL_WIFI " Online");
         lv_obj_set_style_text_color(icon, lv_color_hex(0x00FF00), 0);
     } else {
@@ -105,11 +118,46 @@ static void status_timer_cb(lv_timer_t * t) {
     }
 }
 
+// Pending orders: the one on the air first, then how many wait behind it
+static void orders_timer_cb(lv_timer_t * t) {
+    lv_obj_t * lbl = (lv_obj_t *)lv_timer_get_user_data(t);
+    if (!lbl) return;
+
+    const OrderQueue& orders = ESPNowManager::getInstance().getOrders();
+    if (!orders.empty()) {
+        const OrderQueue::Order& o = orders[0];
+        char text[96];
+        if (o.state == OrderQueue::ORDER_SENT) {
+            snprintf(text, sizeof(text), LV_SYMBOL_UPLOAD " %s (try %d)", o.name.c_str(), o.attempts);
+        } else {
+            snprintf(text, sizeof(text), LV_SYMBOL_UPLOAD " %s (waiting)", o.name.c_str());
+        }
+        if (orders.size() > 1) {
+            size_t n = strlen(text);
+            snprintf(text + n, sizeof(text) - n, "  +%d queued%s", (int)orders.size() - 1, orders.full() ? " (full)" : "");
+        }
+        lv_label_set_text(lbl, text);
+        lv_obj_set_style_text_color(lbl, lv_color_hex(0xFFFF00), 0);
+    } else if (orders.lastFinished().id != 0) {
+        const OrderQueue::Order& o = orders.lastFinished();
+        if (o.state == OrderQueue::ORDER_DELIVERED) {
+            lv_label_set_text_fmt(lbl, LV_SYMBOL_OK " %s (%lu ms)", o.name.c_str(), (unsigned long)o.latencyMs);
+            lv_obj_set_style_text_color(lbl, lv_color_hex(0x00FF00), 0);
+        } else {
+            lv_label_set_text_fmt(lbl, LV_SYMBOL_CLOSE " %s not delivered", o.name.c_str());
+            lv_obj_set_style_text_color(lbl, lv_color_hex(0xFF0000), 0);
+        }
+    } else {
+        lv_label_set_text(lbl, "");
+    }
+}
+
 static void page_cocktails_delete_cb(lv_event_t * e) {
     printf("[Cocktails] Cleaning up timers.\n");
     if (cocktails_refresh_timer) { lv_timer_del(cocktails_refresh_timer); cocktails_refresh_timer = NULL; }
     if (sync_retry_timer) { lv_timer_del(sync_retry_timer); sync_retry_timer = NULL; }
     if (status_timer) { lv_timer_del(status_timer); status_timer = NULL; }
+    if (orders_timer) { lv_timer_del(orders_timer); orders_timer = NULL; }
 }
 
 lv_obj_t* page_cocktails_create(lv_event_cb_t on_nav_click) {
@@ -143,6 +191,16 @@ lv_obj_t* page_cocktails_create(lv_event_cb_t on_nav_click) {
     if (status_timer) lv_timer_del(status_timer);
     status_timer = lv_timer_create(status_timer_cb, 500, conn_icon);
 
+    // Order Status
+    lv_obj_t * orders_lbl = lv_label_create(screen);
+    lv_obj_align(orders_lbl, LV_ALIGN_TOP_LEFT, 20, 15);
+    lv_obj_set_style_text_font(orders_lbl, &lv_font_montserrat_14, 0);
+    lv_label_set_text(orders_lbl, "");
+
+    if (orders_timer) lv_timer_del(orders_timer);
+    orders_timer = lv_timer_create(orders_timer_cb, 250, orders_lbl);
+    orders_timer_cb(orders_timer);
+
     // Grid Container
     // Grid/Flex Container
     grid_cocktails_cont = lv_obj_create(screen);
@@ -167,18 +225,24 @@ lv_obj_t* page_cocktails_create(lv_event_cb_t on_nav_click) {
     lv_obj_add_event_cb(screen, page_cocktails_delete_cb, LV_EVENT_DELETE, NULL);
 
     // Initial Sync/Mock logic
-    if (!DataManager::getInstance().isRecipesSynced() || DataManager::getInstance().getRecipes().empty()) {
+    const CatalogSnapshot & snap = DataManager::getInstance().snapshot();
+    if (!snap.recipesSynced || snap.recipes.empty()) {
         printf("[Cocktails] Cache empty. Loading fallback mocks & Starting Sync Retry.\n");
         DataManager::getInstance().loadMocks(); // Proactive load
         
         // Trigger first sync immediately
         ESPNowManager::getInstance().requestRecipeSync();
         ESPNowManager::getInstance().requestPumpSync();
+    } else if (snap.usingCache) {
+        // Showing the NVS copy: ask the controller whether it is still current
+        ESPNowManager::getInstance().requestRecipeSync();
+        ESPNowManager::getInstance().requestPumpSync();
     }
 
-    // Initial draw
-    refresh_grid();
-    last_processed_update = DataManager::getInstance().getLastUpdate();
+    // Initial draw, from the mocks if they were just loaded
+    const CatalogSnapshot & shown = DataManager::getInstance().snapshot();
+    refresh_grid(shown);
+    last_processed_update = shown.version;
 
     // Start Retry Timer (checks every 5s if we are still on mocks)
     if (sync_retry_timer) lv_timer_del(sync_retry_timer);
@@ -18,28 +18,30 @@ static lv_timer_t * status_timer = NULL;
 static lv_timer_t * refresh_timer = NULL;
 static lv_timer_t * sync_retry_timer = NULL;
 static lv_obj_t * grid_config_cont = NULL;
-static unsigned long last_processed_update = 0;
+static uint32_t last_processed_update = 0;
 
-static void create_config_card(lv_obj_t * parent, const ICocktail * cocktail);
+static lv_obj_t * create_config_card(lv_obj_t * parent, RecipeHandle handle, const ICocktail & cocktail);
 static void load_mock_recipes();
 
-static void refresh_grid() {
+// One snapshot for the whole grid: every card comes from the same catalogue
+static void refresh_grid(const CatalogSnapshot & snap) {
     if (!grid_config_cont) return;
     lv_obj_clean(grid_config_cont);
 
-    const auto& recipes = DataManager::getInstance().getRecipes();
+    const RecipeStore & recipes = snap.recipes;
     for(size_t i=0; i < recipes.size(); i++) {
-         create_config_card(grid_config_cont, &recipes[i]);
-         lv_obj_set_grid_cell(lv_obj_get_child(grid_config_cont, i), LV_GRID_ALIGN_STRETCH, i%4, 1, LV_GRID_ALIGN_STRETCH, i/4, 1);
+         lv_obj_t * card = create_config_card(grid_config_cont, recipes.handleAt(i), recipes[i]);
+         lv_obj_set_grid_cell(card, LV_GRID_ALIGN_STRETCH, i%4, 1, LV_GRID_ALIGN_STRETCH, i/4, 1);
     }
 }
 
 // UI Thread Timer to refresh if DataManager updated
 static void refresh_timer_cb(lv_timer_t * t) {
-    if (DataManager::getInstance().getLastUpdate() > last_processed_update) {
+    const CatalogSnapshot & snap = DataManager::getInstance().snapshot();
+    if (snap.version > last_processed_update) {
         printf("[UI] DataManager updated. Refreshing grid...\n");
-        last_processed_update = DataManager::getInstance().getLastUpdate();
-        refresh_grid();
+        last_processed_update = snap.version;
+        refresh_grid(snap);
     }
 }
 
@@ -47,7 +49,11 @@ static void status_timer_cb(lv_timer_t * t) {
     lv_obj_t * icon = (lv_obj_t *)lv_timer_get_user_data(t);
     if (!icon) return;
 
-    if (!DataManager::getInstance().isUsingMocks()) {
+    const CatalogSnapshot & snap = DataManager::getInstance().snapshot();
+    if (snap.usingCache) {
+        lv_label_set_text(icon, LV_SYMBOL_REFRESH " Cached");
+        lv_obj_set_style_text_color(icon, lv_color_hex(0xFFFF00), 0);
+    } else if (!snap.usingMocks) {
         lv_label_set_text(icon, LV_SYMBOL_WIFI " Online");
         lv_obj_set_style_text_color(icon, lv_color_hex(0x00FF00), 0);
     } else {
@@ -59,8 +65,9 @@ static void status_timer_cb(lv_timer_t * t) {
 
 
 static void sync_retry_timer_cb(lv_timer_t * t) {
-    if (DataManager::getInstance().isUsingMocks()) {
-        printf("[Config] Still using mocks. Retrying Sync Request...\n");
+    const CatalogSnapshot & snap = DataManager::getInstance().snapshot();
+    if (snap.usingMocks || snap.usingCache) {
+        printf("[Config] Still on mocks/cache. Retrying Sync Request...\n");
         ESPNowManager::getInstance().requestRecipeSync();
         ESPNowManager::getInstance().requestPumpSync();
     } else {
@@ -78,16 +85,18 @@ static void page_config_delete_cb(lv_event_t * e) {
 }
 
 static void init_recipes() {
+    const CatalogSnapshot & snap = DataManager::getInstance().snapshot();
+
     // 1. Initial background request if not synced
-    if (!DataManager::getInstance().isRecipesSynced()) {
-        printf("[UI] Global Cache empty. Requesting from Server...\n");
+    if (!snap.recipesSynced || snap.usingCache) {
+        printf("[UI] Global Cache empty or unconfirmed. Requesting from Server...\n");
         ESPNowManager::getInstance().requestRecipeSync();
         ESPNowManager::getInstance().requestPumpSync();
     }
     
     // 2. Initial Draw from Cache
-    refresh_grid();
-    last_processed_update = DataManager::getInstance().getLastUpdate();
+    refresh_grid(snap);
+    last_processed_update = snap.version;
 
     // 3. Create Refresh Timer to catch background updates
     if (!refresh_timer) {
@@ -95,17 +104,15 @@ static void init_recipes() {
     }
 
     // 4. Start Retry Timer if using Mocks
-    if (DataManager::getInstance().isUsingMocks() || !DataManager::getInstance().isRecipesSynced()) {
+    if (snap.usingMocks || snap.usingCache || !snap.recipesSynced) {
         if (sync_retry_timer) lv_timer_del(sync_retry_timer);
         sync_retry_timer = lv_timer_create(sync_retry_timer_cb, SYNC_RETRY_INTERVAL_MS, NULL);
     }
 }
 
 static void load_mock_recipes() {
-    auto mockCocktails = getDefaultMockCocktails();
-    for (const auto& mock : mockCocktails) {
-        ICocktail c = mock; // Directly assign since types now match!
-        DataManager::getInstance().addRecipeFromConfig(c);
+    for (const auto& mock : getDefaultMockCocktails()) {
+        DataManager::getInstance().addRecipeFromConfig(mock);
     }
 }
 
@@ -120,33 +127,12 @@ static void on_recipe_save(ICocktail * c) {
     // Name
     strncpy(data.name, c->name.c_str(), sizeof(data.name) - 1);
     
-    // Ingredients Mapping
-    // Client has Name/Qty. Server Protocol expects array [0..3] corresponding to Pump 1..4.
-    // We strictly map by Pump Name standard? Or just trust the order?
-    // DataManager mapMetadata uses names to assign icons.
-    // Here we need to map "Cocacola" -> Pump 1 (Index 0)
-    // "Orange Juice" -> Pump 2 (Index 1)
-    // "Vodka" -> Pump 3 (Index 2)
-    // "Grenadine" -> Pump 4 (Index 3)
-    
-    // We assume standard names for now as defined in Config/DataManager.
-    // If user renamed liquid in pumps, we might have a mismatch if we don't know the pump config here.
-    // But DataManager has getPumpSettings()... but that lacks liquid names.
-    // HOWEVER, the `ICocktail` came from DataManager which was synced from Server.
-    // The Server uses specific names. 
-    // We will do a generic map based on the ingredient name string match.
-    
+    // Ingredients Mapping: protocol array [0..3] is Pump 1..4
     for (const auto& ing : c->ingredients) {
-        if (ing.name.indexOf("Coca") >= 0) data.ingredientsMl[0] = ing.quantity;
-        else if (ing.name.indexOf("Orange") >= 0) data.ingredientsMl[1] = ing.quantity;
-        else if (ing.name.indexOf("Vodka") >= 0) data.ingredientsMl[2] = ing.quantity;
-        else if (ing.name.indexOf("Grenadine") >= 0) data.ingredientsMl[3] = ing.quantity;
-        // Fallback or other ingredients? 
-        // If we strictly follow the Defaults:
-        // Pump 1: Cocacola
-        // Pump 2: Orange Juice
-        // Pump 3: Vodka
-        // Pump 4: Grenadine
+        int pump = ing.pump;
+        if (pump < 1 || pump > 4) pump = DataManager::getInstance().pumpForIngredient(ing.name.c_str());
+        if (pump >= 1 && pump <= 4) data.ingredientsMl[pump - 1] = ing.quantity;
+        else printf("[Config] No pump for ingredient %s, skipped.\n", ing.name.c_str());
     }
 
     // Index & Total are less relevant for Update, but let's keep them zero or valid if we knew them.
@@ -162,14 +148,18 @@ static void on_recipe_save(ICocktail * c) {
 }
 
 static void on_edit_click(lv_event_t * e) {
-    ICocktail * cocktail = (ICocktail *)lv_event_get_user_data(e);
+    // Cards hold handles: a recipe removed by a sync since the grid was drawn resolves to nullptr
+    RecipeHandle handle = RecipeHandle::fromUserData(lv_event_get_user_data(e));
+    const ICocktail * cocktail = DataManager::getInstance().getRecipe(handle);
     if (cocktail) {
         printf("Editing recipe: %s\n", cocktail->name.c_str());
         create_recipe_modal(lv_scr_act(), cocktail, on_recipe_save);
+    } else {
+        printf("[Config] Recipe no longer exists, ignoring edit.\n");
     }
 }
 
-static void create_config_card(lv_obj_t * parent, const ICocktail * cocktail) {
+static lv_obj_t * create_config_card(lv_obj_t * parent, RecipeHandle handle, const ICocktail & cocktail) {
     lv_obj_t * card = lv_obj_create(parent);
     lv_obj_clear_flag(card, LV_OBJ_FLAG_SCROLLABLE); 
     lv_obj_add_flag(card, LV_OBJ_FLAG_CLICKABLE); // Fix: The whole card is now clickable
@@ -177,7 +167,7 @@ static void create_config_card(lv_obj_t * parent, const ICocktail * cocktail) {
     lv_obj_set_height(card, 220);
     lv_obj_set_style_bg_color(card, lv_color_hex(0x202020), 0);
     lv_obj_set_style_bg_opa(card, LV_OPA_COVER, 0);
-    lv_obj_set_style_border_color(card, lv_color_hex(cocktail->color), 0);
+    lv_obj_set_style_border_color(card, lv_color_hex(cocktail.color), 0);
     lv_obj_set_style_border_width(card, 2, 0);
     lv_obj_set_style_radius(card, 15, 0);
     lv_obj_set_flex_flow(card, LV_FLEX_FLOW_COLUMN);
@@ -187,7 +177,7 @@ static void create_config_card(lv_obj_t * parent, const ICocktail * cocktail) {
     lv_obj_set_style_pad_row(card, 5, 0); // Small gap between sections
 
     // Add Event to the main card
-    lv_obj_add_event_cb(card, on_edit_click, LV_EVENT_CLICKED, (void*)cocktail);
+    lv_obj_add_event_cb(card, on_edit_click, LV_EVENT_CLICKED, handle.toUserData());
 
     // 1. Image Container (Fixed Height to prevent overflow)
     lv_obj_t * img_cont = lv_obj_create(card);
@@ -200,16 +190,16 @@ static void create_config_card(lv_obj_t * parent, const ICocktail * cocktail) {
     
     // Icon
     lv_obj_t * img = lv_image_create(img_cont); 
-    lv_image_set_src(img, cocktail->icon);
+    lv_image_set_src(img, cocktail.icon);
     lv_image_set_scale(img, 128); 
-    lv_obj_set_style_img_recolor(img, lv_color_hex(cocktail->color), 0);
+    lv_obj_set_style_img_recolor(img, lv_color_hex(cocktail.color), 0);
     lv_obj_set_style_img_recolor_opa(img, LV_OPA_30, 0); 
     lv_obj_center(img); 
 
     // 2. Title
     lv_obj_t * label = lv_label_create(card);
     lv_obj_clear_flag(label, LV_OBJ_FLAG_CLICKABLE); // Transparent to clicks
-    lv_label_set_text(label, cocktail->name.c_str());
+    lv_label_set_text(label, cocktail.name.c_str());
     lv_obj_set_style_text_font(label, &lv_font_montserrat_16, 0); 
     lv_obj_set_style_text_color(label, lv_color_white(), 0);
     lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
@@ -235,6 +225,8 @@ static void create_config_card(lv_obj_t * parent, const ICocktail * cocktail) {
     lv_label_set_text(btn_lbl, LV_SYMBOL_EDIT " EDITAR");
     lv_obj_set_style_text_font(btn_lbl, &lv_font_montserrat_14, 0);
     lv_obj_center(btn_lbl);
+
+    return card;
 }
 
 lv_obj_t* page_config_create(lv_event_cb_t on_nav_back, lv_event_cb_t on_nav_next) {
@@ -285,8 +277,7 @@ lv_obj_t* page_config_create(lv_event_cb_t on_nav_back, lv_event_cb_t on_nav_nex
     lv_obj_set_style_pad_row(grid_config_cont, 15, 0); 
 
     // Initialize (triggers Sync or Mock)
-    init_recipes();
-    refresh_grid(); // Initial draw (empty or mock)
+    init_recipes(); // Initial draw (empty or mock)
 
     // Footer container
     create_nav_footer(screen, on_nav_back, on_nav_next);
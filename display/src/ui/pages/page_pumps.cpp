@@ -22,26 +22,16 @@ static lv_timer_t * sync_check_timer = NULL;
 static lv_timer_t * sync_retry_timer = NULL; // New: Retry timer
 static bool sync_applied = false;
 
-// NVS Keys
-static const char* KEY_P1_PWM = "p1_pwm";
-static const char* KEY_P1_TIME = "p1_time";
-static const char* KEY_P2_PWM = "p2_pwm";
-static const char* KEY_P2_TIME = "p2_time";
-static const char* KEY_P3_PWM = "p3_pwm";
-static const char* KEY_P3_TIME = "p3_time";
-static const char* KEY_P4_PWM = "p4_pwm";
-static const char* KEY_P4_TIME = "p4_time";
-
 struct PumpConfigData {
     lv_obj_t* label_val; 
-    const char* key;
+    int pump_id; // 1 - 4, as the controller numbers them
     int* val_ptr; 
     bool is_time; // false for PWM, true for Time
 };
 
-// Load values from NVS
-static void load_settings() {
-    auto& pumps = DataManager::getInstance().getPumpSettings();
+// Load values from the snapshot the caller is working from
+static void load_settings(const CatalogSnapshot & snap) {
+    const IPumpSettings & pumps = snap.pumps;
     if (pumps.synced) {
         printf("[Pumps] Loading from DataManager Cache.\n");
         p1_pwm = pumps.pwm[0];
@@ -93,26 +83,22 @@ static void pump_slider_event_cb(lv_event_t * e) {
 
     // 3. Send to Server (Only on release)
     if (lv_event_get_code(e) == LV_EVENT_RELEASED) {
-        if (data->key) {
-            // Identify Pump ID from Key (e.g. "p1_pwm")
-            int pumpId = 0;
-            int pwm_val = 0;
-            int time_val = 0;
-
-            if (strstr(data->key, "p1")) {
-                pumpId = 1; pwm_val = p1_pwm; time_val = p1_time;
-            } else if (strstr(data->key, "p2")) {
-                pumpId = 2; pwm_val = p2_pwm; time_val = p2_time;
-            } else if (strstr(data->key, "p3")) {
-                pumpId = 3; pwm_val = p3_pwm; time_val = p3_time;
-            } else if (strstr(data->key, "p4")) {
-                pumpId = 4; pwm_val = p4_pwm; time_val = p4_time;
-            }
-
-            if (pumpId > 0) {
-                printf("[Pumps] Sending Update for Pump %d (PWM: %d, Time: %d ms)\n", pumpId, pwm_val, time_val);
-                ESPNowManager::getInstance().sendPumpCalibration(pumpId, pwm_val, time_val);
-            }
+        // Both values of the pump go out together
+        int pumpId = data->pump_id;
+        int pwm_val = 0;
+        int time_val = 0;
+
+        switch (pumpId) {
+            case 1: pwm_val = p1_pwm; time_val = p1_time; break;
+            case 2: pwm_val = p2_pwm; time_val = p2_time; break;
+            case 3: pwm_val = p3_pwm; time_val = p3_time; break;
+            case 4: pwm_val = p4_pwm; time_val = p4_time; break;
+            default: pumpId = 0; break;
+        }
+
+        if (pumpId > 0) {
+            printf("[Pumps] Queued Update for Pump %d (PWM: %d, Time: %d ms)\n", pumpId, pwm_val, time_val);
+            ESPNowManager::getInstance().queuePumpCalibration(pumpId, pwm_val, time_val);
         }
     }
 }
@@ -122,7 +108,7 @@ static void slider_cleanup_cb(lv_event_t * e) {
     if (data) delete data;
 }
 
-static void create_pump_card(lv_obj_t * parent, const char * name, int* pwm_ptr, const char* pwm_key, int* time_ptr, const char* time_key) {
+static void create_pump_card(lv_obj_t * parent, const char * name, int pump_id, int* pwm_ptr, int* time_ptr) {
     lv_obj_t * card = lv_obj_create(parent);
     lv_obj_set_width(card, LV_PCT(48)); 
     lv_obj_set_height(card, LV_SIZE_CONTENT);
@@ -159,7 +145,7 @@ static void create_pump_card(lv_obj_t * parent, const char * name, int* pwm_ptr,
 
     PumpConfigData * pwm_data = new PumpConfigData();
     pwm_data->label_val = lbl_pwm_val;
-    pwm_data->key = pwm_key;
+    pwm_data->pump_id = pump_id;
     pwm_data->val_ptr = pwm_ptr;
     pwm_data->is_time = false;
 
@@ -193,7 +179,7 @@ static void create_pump_card(lv_obj_t * parent, const char * name, int* pwm_ptr,
 
     PumpConfigData * time_data = new PumpConfigData();
     time_data->label_val = lbl_time_val;
-    time_data->key = time_key;
+    time_data->pump_id = pump_id;
     time_data->val_ptr = time_ptr;
     time_data->is_time = true;
 
@@ -206,9 +192,10 @@ static void create_pump_card(lv_obj_t * parent, const char * name, int* pwm_ptr,
 }
 
 static void sync_check_timer_cb(lv_timer_t * t) {
-    if (!sync_applied && DataManager::getInstance().getPumpSettings().synced) {
+    const CatalogSnapshot & snap = DataManager::getInstance().snapshot();
+    if (!sync_applied && snap.pumps.synced) {
         printf("[Pumps] Server data arrived in Cache! Reloading settings...\n");
-        load_settings();
+        load_settings(snap);
         // Option 1: Re-draw the screen. Option 2: Individual updates. 
         // Re-drawing is safest to ensure all sliders match.
         lv_obj_t* screen = lv_obj_get_screen((lv_obj_t*)lv_timer_get_user_data(t));
@@ -223,7 +210,10 @@ static void sync_check_timer_cb(lv_timer_t * t) {
     lv_obj_t* icon = (lv_obj_t*)lv_timer_get_user_data(t);
     if (icon) {
         // Logic Update: Check Data Valid (!UsingMocks) instead of Link Beat
-        if (!DataManager::getInstance().isUsingMocks()) {
+        if (snap.pumpsFromCache) {
+            lv_label_set_text(icon, LV_SYMBOL_REFRESH " Cached");
+            lv_obj_set_style_text_color(icon, lv_color_hex(0xFFFF00), 0);
+        } else if (!snap.usingMocks) {
             lv_label_set_text(icon, LV_SYMBOL_WIFI " Online");
             lv_obj_set_style_text_color(icon, lv_color_hex(0x00FF00), 0);
         } else {
@@ -244,13 +234,15 @@ static void update_sliders_from_datamanager() {
 static void refresh_timer_cb(lv_timer_t * t) {
     // Check if DataManager has new data. For pumps, we check lastUpdate.
     // Simplification: We just want to catch the transition from Mock -> Real
-    if (DataManager::getInstance().isRecipesSynced() && !DataManager::getInstance().isUsingMocks()) {
+    const CatalogSnapshot & snap = DataManager::getInstance().snapshot();
+    if (snap.recipesSynced && !snap.usingMocks) {
          // Reload UI if we just got real data
     }
 }
 
 static void sync_retry_timer_cb(lv_timer_t * t) {
-    if (DataManager::getInstance().isUsingMocks()) {
+    const CatalogSnapshot & snap = DataManager::getInstance().snapshot();
+    if (snap.usingMocks) {
         printf("[Pumps] Still using mocks. Retrying Sync Request...\n");
         ESPNowManager::getInstance().requestPumpSync(); // Explicitly ask for pumps too
         ESPNowManager::getInstance().requestRecipeSync();
@@ -260,7 +252,7 @@ static void sync_retry_timer_cb(lv_timer_t * t) {
         sync_retry_timer = NULL;
         
         // Reload settings on transition
-        load_settings(); 
+        load_settings(snap);
     }
 }
 
@@ -277,7 +269,8 @@ static void page_pumps_delete_cb(lv_event_t * e) {
 lv_obj_t* page_pumps_create(lv_event_cb_t on_nav_back) {
     sync_applied = false;
     ESPNowManager::getInstance().requestPumpSync(); // Fetch latest from server
-    load_settings();
+    const CatalogSnapshot & snap = DataManager::getInstance().snapshot();
+    load_settings(snap);
 
     lv_obj_t* screen = lv_obj_create(NULL);
     lv_obj_set_style_bg_color(screen, lv_color_hex(0x202020), LV_PART_MAIN);
@@ -287,7 +280,7 @@ lv_obj_t* page_pumps_create(lv_event_cb_t on_nav_back) {
     lv_obj_add_event_cb(screen, page_pumps_delete_cb, LV_EVENT_DELETE, NULL);
 
     // Initial Sync request if needed
-    if (!DataManager::getInstance().getPumpSettings().synced) {
+    if (!snap.pumps.synced) {
         ESPNowManager::getInstance().requestPumpSync();
         
         // Start Retry Timer
@@ -303,7 +296,10 @@ lv_obj_t* page_pumps_create(lv_event_cb_t on_nav_back) {
     lv_obj_set_style_text_font(conn_icon, &lv_font_montserrat_14, 0);
 
     // Initial State
-    if (!DataManager::getInstance().isUsingMocks()) {
+    if (snap.pumpsFromCache) {
+        lv_label_set_text(conn_icon, LV_SYMBOL_REFRESH " Cached");
+        lv_obj_set_style_text_color(conn_icon, lv_color_hex(0xFFFF00), 0);
+    } else if (!snap.usingMocks) {
         lv_label_set_text(conn_icon, LV_SYMBOL_WIFI " Online");
         lv_obj_set_style_text_color(conn_icon, lv_color_hex(0x00FF00), 0);
     } else {
@@ -324,10 +320,10 @@ lv_obj_t* page_pumps_create(lv_event_cb_t on_nav_back) {
     lv_obj_set_style_pad_row(grid_cont, 10, 0);
     lv_obj_set_style_pad_column(grid_cont, 10, 0);
 
-    create_pump_card(grid_cont, "Cocacola", &p1_pwm, KEY_P1_PWM, &p1_time, KEY_P1_TIME);
-    create_pump_card(grid_cont, "Orange Juice", &p2_pwm, KEY_P2_PWM, &p2_time, KEY_P2_TIME);
-    create_pump_card(grid_cont, "Vodka", &p3_pwm, KEY_P3_PWM, &p3_time, KEY_P3_TIME);
-    create_pump_card(grid_cont, "Grenadine", &p4_pwm, KEY_P4_PWM, &p4_time, KEY_P4_TIME);
+    create_pump_card(grid_cont, "Cocacola", 1, &p1_pwm, &p1_time);
+    create_pump_card(grid_cont, "Orange Juice", 2, &p2_pwm, &p2_time);
+    create_pump_card(grid_cont, "Vodka", 3, &p3_pwm, &p3_time);
+    create_pump_card(grid_cont, "Grenadine", 4, &p4_pwm, &p4_time);
 
     // Footer using centralized component
     create_simple_nav_footer(screen, on_nav_back);
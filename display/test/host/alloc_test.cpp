@@ -0,0 +1,81 @@
+// A full recipe + pump sync must not touch the heap once DataManager is warmed up.
+// Counts every operator new while the controller's sync is replayed into it.
+#include <new>
+#include <cstdlib>
+#include "core/DataManager.hpp"
+
+static volatile bool counting = false;
+static volatile long allocations = 0;
+
+void* operator new(size_t n) {
+    if (counting) allocations++;
+    void* p = malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void* operator new[](size_t n) { return operator new(n); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+#define SYNC_RECIPES 20
+#define WARMUP_ROUNDS 1
+#define ROUNDS 5
+
+// What onDataRecv hands DataManager for one sync: pumps, then every recipe part
+static void fullSync(int round) {
+    DataManager& dm = DataManager::getInstance();
+
+    PumpSyncData pumps = {};
+    for (int i = 0; i < 4; i++) {
+        pumps.pwm[i] = 100 + round + i;
+        pumps.calibration[i] = 1.5f + i;
+    }
+    dm.updatePumps(pumps);
+
+    for (int i = 0; i < SYNC_RECIPES; i++) {
+        RecipeSyncData d = {};
+        // Same catalogue every round, new quantities. Full 32 bytes, no terminator,
+        // like the longest names on the wire.
+        char name[RECIPE_NAME_LEN + 1];
+        snprintf(name, sizeof(name), "Recipe %02d ......................", i);
+        memcpy(d.name, name, sizeof(d.name));
+        d.index = i;
+        d.total = SYNC_RECIPES;
+        d.ingredientsMl[i % 4] = 50 + round;
+        d.ingredientsMl[(i + 1) % 4] = 20;
+        d.iconId = i % 7;
+        dm.addRecipe(d);
+    }
+    dm.confirmRecipes();
+    dm.confirmPumps();
+
+    // The LVGL loop between frames
+    dm.releaseSnapshots();
+}
+
+int main() {
+    DataManager& dm = DataManager::getInstance();
+    dm.loadMocks();
+    dm.releaseSnapshots();
+
+    for (int round = 0; round < WARMUP_ROUNDS; round++) fullSync(round);
+
+    int failed = 0;
+    for (int round = WARMUP_ROUNDS; round < WARMUP_ROUNDS + ROUNDS; round++) {
+        allocations = 0;
+        counting = true;
+        fullSync(round);
+        counting = false;
+
+        const CatalogSnapshot& s = dm.snapshot();
+        bool applied = s.recipes.size() == SYNC_RECIPES && s.pumps.pwm[0] == 100 + round;
+        printf("round %d: %ld allocation(s), %d recipes, version %lu%s\n", round, allocations,
+               (int)s.recipes.size(), (unsigned long)s.version, applied ? "" : " NOT APPLIED");
+        if (allocations != 0 || !applied) failed++;
+    }
+
+    printf("alloc_test: %s\n", failed ? "FAIL" : "PASS (full sync without heap allocations)");
+    return failed ? 1 : 0;
+}
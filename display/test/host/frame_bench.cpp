@@ -0,0 +1,156 @@
+// Compact ESP-NOW frames (remote_frame.hpp): round trip check on a typical
+// session's messages, then their average size and encode / decode cost.
+#include <chrono>
+#include <random>
+#include <vector>
+#include "core/remote_frame.hpp"
+
+#define BENCH_ITERATIONS 200000
+#define FUZZ_FRAMES 200000
+
+static struct_message makeMessage(int id) {
+    struct_message m;
+    memset(&m, 0, sizeof(m));
+    m.id = id;
+    return m;
+}
+
+// What one display exchanges with the controller from boot to a first order
+static std::vector<struct_message> sessionMessages(std::mt19937& rng) {
+    std::vector<struct_message> mix;
+
+    struct_message m = makeMessage(REMOTE_CMD_SYNC_REQUEST);
+    m.idReading = (int)rng();
+    m.temp = REMOTE_FRAME_VERSION;
+    mix.push_back(m);
+
+    m = makeMessage(REMOTE_CMD_RECIPE_SYNC_REQUEST);
+    m.idReading = (int)rng();
+    mix.push_back(m);
+
+    m = makeMessage(REMOTE_CMD_SYNC_RESPONSE);
+    for (int i = 0; i < 4; i++) {
+        m.pumpValues.pwm[i] = rng() % 256;
+        m.pumpValues.calibration[i] = (rng() % 60000) / 1000.0f;
+    }
+    mix.push_back(m);
+
+    for (int i = 0; i < 8; i++) {
+        m = makeMessage(REMOTE_CMD_RECIPE_DATA);
+        m.recipeData.index = i;
+        m.recipeData.total = 8;
+        snprintf(m.recipeData.name, sizeof(m.recipeData.name), "Recipe %d", i);
+        m.recipeData.ingredientsMl[i % 4] = 50 + i;
+        m.recipeData.iconId = i % RECIPE_ICON_COUNT;
+        mix.push_back(m);
+    }
+
+    m = makeMessage(REMOTE_CMD_SYNC_UNCHANGED);
+    m.idReading = REMOTE_CMD_RECIPE_SYNC_REQUEST;
+    mix.push_back(m);
+
+    m = makeMessage(REMOTE_CMD_PUMP_CALIBRATION);
+    PumpCalibrationData cal = {};
+    cal.count = 2;
+    cal.pumps[0] = {1, 0, 200, 1600};
+    cal.pumps[1] = {3, 0, 180, 2400};
+    m.pumpCalibration = cal;
+    mix.push_back(m);
+
+    m = makeMessage(REMOTE_CMD_DRINK_ORDER);
+    m.idReading = 1;
+    strcpy(m.choose, "Vodka Coke");
+    mix.push_back(m);
+
+    m = makeMessage(REMOTE_CMD_ORDER_ACK);
+    m.idReading = 1;
+    mix.push_back(m);
+    return mix;
+}
+
+// Fields each message carries; the rest of struct_message is not sent
+static bool sameMessage(const struct_message& a, const struct_message& b) {
+    if (a.id != b.id || a.idReading != b.idReading || a.temp != b.temp) return false;
+    switch (a.id) {
+        case REMOTE_CMD_SYNC_RESPONSE: {
+            PumpSyncData x = a.pumpValues, y = b.pumpValues;
+            return memcmp(&x, &y, sizeof(x)) == 0;
+        }
+        case REMOTE_CMD_RECIPE_DATA: {
+            RecipeSyncData x = a.recipeData, y = b.recipeData;
+            return memcmp(&x, &y, sizeof(x)) == 0;
+        }
+        case REMOTE_CMD_PUMP_CALIBRATION: {
+            PumpCalibrationData x = a.pumpCalibration, y = b.pumpCalibration;
+            return x.count == y.count && memcmp(x.pumps, y.pumps, x.count * sizeof(x.pumps[0])) == 0;
+        }
+        case REMOTE_CMD_DRINK_ORDER:
+        case REMOTE_CMD_PUMP_UPDATE:
+            return strcmp(a.choose, b.choose) == 0;
+        default:
+            return true;
+    }
+}
+
+int main() {
+    std::mt19937 rng(1);
+    std::vector<struct_message> mix = sessionMessages(rng);
+    uint8_t frame[REMOTE_FRAME_MAX];
+    int failed = 0;
+
+    // Round trips: compact, and legacy frames still decode as they are
+    size_t compactBytes = 0;
+    std::vector<std::vector<uint8_t>> encoded;
+    for (const auto& m : mix) {
+        size_t len = remote_frame_encode(m, frame, sizeof(frame));
+        struct_message d;
+        bool compact = false;
+        if (len == 0 || !remote_frame_decode(frame, len, d, &compact) || !compact || !sameMessage(m, d)) {
+            printf("round trip FAILED for message %d\n", m.id);
+            failed++;
+        }
+        struct_message legacy;
+        if (!remote_frame_decode((const uint8_t*)&m, sizeof(m), legacy, &compact) || compact ||
+            memcmp(&legacy, &m, sizeof(m)) != 0) {
+            printf("legacy decode FAILED for message %d\n", m.id);
+            failed++;
+        }
+        compactBytes += len;
+        encoded.emplace_back(frame, frame + len);
+    }
+
+    // Garbage behind a valid header must be rejected without reading past the frame
+    for (int i = 0; i < FUZZ_FRAMES; i++) {
+        uint8_t junk[64];
+        size_t len = rng() % sizeof(junk);
+        for (size_t k = 0; k < len; k++) junk[k] = (uint8_t)rng();
+        if (len > 1) {
+            junk[0] = REMOTE_FRAME_MAGIC;
+            junk[1] = REMOTE_FRAME_VERSION;
+        }
+        struct_message d;
+        remote_frame_decode(junk, len, d);
+    }
+
+    size_t sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        sink += remote_frame_encode(mix[i % mix.size()], frame, sizeof(frame));
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        const auto& e = encoded[i % encoded.size()];
+        struct_message d;
+        sink += remote_frame_decode(e.data(), e.size(), d);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double encodeNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / BENCH_ITERATIONS;
+    double decodeNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / BENCH_ITERATIONS;
+    printf("%d messages: compact %.1f bytes avg, legacy %d bytes\n",
+           (int)mix.size(), (double)compactBytes / mix.size(), (int)sizeof(struct_message));
+    printf("encode %.0f ns, decode %.0f ns per message (host, %zu)\n", encodeNs, decodeNs, sink);
+
+    printf("frame_bench: %s\n", failed ? "FAIL" : "PASS");
+    return failed ? 1 : 0;
+}
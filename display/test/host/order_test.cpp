@@ -0,0 +1,96 @@
+// OrderQueue retry rules and the OrderEventRing the radio callbacks feed it through.
+#include "core/OrderQueue.hpp"
+
+static int failures = 0;
+
+#define CHECK(cond)                                                   \
+    do {                                                              \
+        if (!(cond)) {                                                \
+            printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++;                                               \
+        }                                                             \
+    } while (0)
+
+// Controller without order ACKs: a slow link result must never cause a resend
+static void legacyResendsOnlyAfterLinkFailure() {
+    OrderQueue q;
+    uint32_t now = 1000;
+    uint16_t id = q.push("Vodka", now);
+    OrderQueue::Order* o = q.due(now);
+    CHECK(o && o->id == id);
+    q.markSent(*o, now, false);
+
+    CHECK(q.due(now + ORDER_RETRY_MAX_MS * 4) == nullptr); // no result yet, no resend
+    CHECK(!q.linkFailed(id + 1));                          // stale id
+    CHECK(q.linkFailed(id));
+    CHECK(q.due(now + 1) == nullptr);                      // still backing off
+    o = q.due(now + ORDER_RETRY_BASE_MS);
+    CHECK(o && o->id == id);
+
+    q.markSent(*o, now + ORDER_RETRY_BASE_MS, false);
+    CHECK(q.acknowledge(id, now + ORDER_RETRY_BASE_MS + 5));
+    CHECK(q.empty() && q.getMetrics().delivered == 1 && q.getMetrics().retries == 1);
+}
+
+// Controller with order ACKs: a missing ACK is resent on the timer
+static void compactResendsOnTimer() {
+    OrderQueue q;
+    uint32_t now = 0;
+    uint16_t id = q.push("Gin Tonic", now);
+    q.markSent(*q.due(now), now, true);
+    CHECK(q.due(now + ORDER_RETRY_BASE_MS - 1) == nullptr);
+    OrderQueue::Order* o = q.due(now + ORDER_RETRY_BASE_MS);
+    CHECK(o && o->id == id);
+}
+
+static void legacyGivesUp() {
+    OrderQueue q;
+    uint32_t now = 0;
+    uint16_t id = q.push("Ron", now);
+    for (int i = 0; i < ORDER_MAX_ATTEMPTS; i++) {
+        OrderQueue::Order* o = q.due(now);
+        CHECK(o != nullptr);
+        if (!o) return;
+        q.markSent(*o, now, false);
+        CHECK(q.linkFailed(id));
+        now += ORDER_RETRY_MAX_MS;
+    }
+    CHECK(q.due(now) == nullptr);
+    CHECK(q.empty() && q.getMetrics().failed == 1);
+
+    // No link result at all: the queue timeout still ends it
+    id = q.push("Coca", 0);
+    q.markSent(*q.due(0), 0, false);
+    CHECK(q.due(ORDER_TIMEOUT_MS - 1) == nullptr && !q.empty());
+    CHECK(q.due(ORDER_TIMEOUT_MS) == nullptr && q.empty());
+    CHECK(q.lastFinished().id == id && q.lastFinished().state == OrderQueue::ORDER_FAILED);
+}
+
+static void ringKeepsEveryResult() {
+    OrderEventRing ring;
+    OrderEventRing::Event e;
+    CHECK(!ring.pop(e));
+
+    // A link result and the ACK of the same order, then the next order's loss
+    CHECK(ring.push(7, OrderEventRing::ORDER_EVENT_LINK_OK));
+    CHECK(ring.push(7, OrderEventRing::ORDER_EVENT_ACK));
+    CHECK(ring.push(8, OrderEventRing::ORDER_EVENT_LINK_LOST));
+    CHECK(ring.pop(e) && e.id == 7 && e.kind == OrderEventRing::ORDER_EVENT_LINK_OK);
+    CHECK(ring.pop(e) && e.id == 7 && e.kind == OrderEventRing::ORDER_EVENT_ACK);
+    CHECK(ring.pop(e) && e.id == 8 && e.kind == OrderEventRing::ORDER_EVENT_LINK_LOST);
+    CHECK(!ring.pop(e));
+
+    for (int i = 0; i < ORDER_EVENT_RING - 1; i++) CHECK(ring.push(100 + i, OrderEventRing::ORDER_EVENT_ACK));
+    CHECK(!ring.push(999, OrderEventRing::ORDER_EVENT_ACK));
+    CHECK(ring.getDropped() == 1);
+    for (int i = 0; i < ORDER_EVENT_RING - 1; i++) CHECK(ring.pop(e) && e.id == 100 + i);
+}
+
+int main() {
+    legacyResendsOnlyAfterLinkFailure();
+    compactResendsOnTimer();
+    legacyGivesUp();
+    ringKeepsEveryResult();
+    printf("order_test: %s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,34 @@
+// Host stand-in for the Arduino core: just what src/core needs to build with g++
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
+
+// 32 bit like the ESP32, so code storing the time in uint32_t wraps the same way
+inline unsigned long micros() {
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+inline unsigned long millis() { return micros() / 1000; }
+
+class String : public std::string {
+public:
+    using std::string::string;
+    String() {}
+    String(const std::string& s) : std::string(s) {}
+    String(int v) : std::string(std::to_string(v)) {}
+
+    bool equalsIgnoreCase(const String& o) const { return strcasecmp(c_str(), o.c_str()) == 0; }
+    int indexOf(const char* s) const { size_t p = find(s); return p == npos ? -1 : (int)p; }
+    String substring(size_t from, size_t to = npos) const { return String(substr(from, to == npos ? npos : to - from)); }
+    bool startsWith(const char* s) const { return rfind(s, 0) == 0; }
+    void toLowerCase() { for (auto& c : *this) c = (char)tolower(c); }
+    void trim() {}
+};
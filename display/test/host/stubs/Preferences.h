@@ -0,0 +1,42 @@
+// Host stand-in for the ESP32 NVS Preferences: one in-memory map for the whole process
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <Arduino.h>
+
+class Preferences {
+public:
+    bool begin(const char* name, bool readOnly = false) { ns = name; return true; }
+    void end() {}
+
+    size_t getBytesLength(const char* key) {
+        auto it = store().find(ns + "/" + key);
+        return it == store().end() ? 0 : it->second.size();
+    }
+    size_t getBytes(const char* key, void* buf, size_t len) {
+        auto it = store().find(ns + "/" + key);
+        if (it == store().end()) return 0;
+        len = std::min(len, it->second.size());
+        memcpy(buf, it->second.data(), len);
+        return len;
+    }
+    size_t putBytes(const char* key, const void* buf, size_t len) {
+        store()[ns + "/" + key].assign((const uint8_t*)buf, (const uint8_t*)buf + len);
+        return len;
+    }
+    uint8_t getUChar(const char* key, uint8_t def = 0) {
+        uint8_t v = def;
+        return getBytes(key, &v, 1) == 1 ? v : def;
+    }
+    size_t putUChar(const char* key, uint8_t v) { return putBytes(key, &v, 1); }
+
+private:
+    std::string ns;
+
+    static std::map<std::string, std::vector<uint8_t>>& store() {
+        static std::map<std::string, std::vector<uint8_t>> nvs;
+        return nvs;
+    }
+};
@@ -0,0 +1,10 @@
+// Image descriptors the icon table points at (src/ui/assets/images.h); the host never draws them
+#include "ui/assets/images.h"
+
+const lv_image_dsc_t img_cocacola = {};
+const lv_image_dsc_t img_gintonic = {};
+const lv_image_dsc_t img_pornstar_martini = {};
+const lv_image_dsc_t img_ron = {};
+const lv_image_dsc_t img_sex_on_the_beach = {};
+const lv_image_dsc_t img_vodka = {};
+const lv_image_dsc_t img_config = {};
@@ -0,0 +1,11 @@
+// Host stand-in for LVGL: image descriptors only, src/core never draws
+#pragma once
+
+typedef struct { int unused; } lv_image_dsc_t;
+typedef lv_image_dsc_t lv_img_dsc_t;
+
+#define LV_IMG_DECLARE(name) extern const lv_image_dsc_t name;
+#define LV_IMAGE_DECLARE(name) extern const lv_image_dsc_t name;
+#define LV_SYMBOL_LEFT "<"
+#define LV_SYMBOL_RIGHT ">"
+#define LV_SYMBOL_HOME "H"
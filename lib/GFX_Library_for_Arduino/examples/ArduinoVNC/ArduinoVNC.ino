@@ -93,6 +93,10 @@ Arduino_GFX *gfx = new Arduino_ILI9341(bus, DF_GFX_RST, 3 /* rotation */, false
 VNC_GFX *vnc_gfx = new VNC_GFX(gfx);
 arduinoVNC vnc = arduinoVNC(vnc_gfx);
 
+// print merged update and latency stats every VNC_STATS_INTERVAL ms, 0 to disable
+#define VNC_STATS_INTERVAL 10000
+unsigned long next_stats_ms = 0;
+
 void TFTnoWifi(void)
 {
   gfx->fillScreen(RGB565_BLACK);
@@ -258,6 +262,22 @@ void loop()
       handle_keyboard();
     }
     vnc.loop();
+    vnc_gfx->flush();
+#if (VNC_STATS_INTERVAL > 0)
+    if (millis() > next_stats_ms)
+    {
+      vnc_gfx_stats_t stats;
+      vnc_gfx->getStats(&stats);
+      if (stats.updates)
+      {
+        Serial.printf("VNC rects in: %lu, drawn: %lu, copies: %lu, updates: %lu, latency avg: %lu us, max: %lu us\n",
+                      (unsigned long)stats.rects_in, (unsigned long)stats.rects_drawn, (unsigned long)stats.copies, (unsigned long)stats.updates,
+                      (unsigned long)(stats.latency_sum_us / stats.updates), (unsigned long)stats.latency_max_us);
+      }
+      vnc_gfx->resetStats();
+      next_stats_ms = millis() + VNC_STATS_INTERVAL;
+    }
+#endif
     if (!vnc.connected())
     {
       TFTnoVNC();
@@ -9,10 +9,29 @@
 // #define SEPARATE_DRAW_TASK
 #endif
 
+// Pixels of the staging buffer that joins neighbouring update rects before drawing, 0 to draw every rect as it arrives
+#ifndef VNC_GFX_MERGE_PIXELS
+#define VNC_GFX_MERGE_PIXELS (64 * 256)
+#endif
+
+typedef struct
+{
+  uint32_t rects_in;       // draw_area() and draw_rect() calls from the VNC client
+  uint32_t rects_drawn;    // draws issued after merging
+  uint32_t copies;         // CopyRect updates done inside the framebuffer
+  uint32_t updates;        // flush() calls that had something to draw
+  uint32_t latency_max_us; // first rect of an update received until drawn
+  uint64_t latency_sum_us;
+} vnc_gfx_stats_t;
+
 #ifdef SEPARATE_DRAW_TASK
 
 #define NUMBER_OF_DRAW_BUFFER 64
 
+#define DRAW_TYPE_FILL 0
+#define DRAW_TYPE_BITMAP 1
+#define DRAW_TYPE_COPY 2
+
 typedef struct
 {
   xQueueHandle xqh;
@@ -25,7 +44,9 @@ typedef struct
   int16_t y;
   int16_t w;
   int16_t h;
-  bool isBitmap;
+  uint8_t type;
+  int16_t src_x; // DRAW_TYPE_COPY only
+  int16_t src_y;
   uint16_t *buf;
 } DrawData;
 
@@ -36,7 +57,7 @@ static TaskHandle_t _draw_task_handle;
 static DrawData drawDatas[NUMBER_OF_DRAW_BUFFER];
 static int draw_queue_cnt = 0;
 
-static void queueDrawTask(uint32_t x, uint32_t y, uint32_t w, uint32_t h, bool isBitmap, uint16_t *d)
+static void queueDrawTask(uint32_t x, uint32_t y, uint32_t w, uint32_t h, uint8_t type, uint16_t *d, uint32_t src_x = 0, uint32_t src_y = 0)
 {
   log_i("queueDrawTask start.");
   DrawData *dd = &drawDatas[draw_queue_cnt % NUMBER_OF_DRAW_BUFFER];
@@ -44,10 +65,12 @@ static void queueDrawTask(uint32_t x, uint32_t y, uint32_t w, uint32_t h, bool i
   dd->y = y;
   dd->w = w;
   dd->h = h;
-  dd->isBitmap = isBitmap;
+  dd->type = type;
+  dd->src_x = src_x;
+  dd->src_y = src_y;
   log_i("copy data start.");
   uint16_t *p = &dd->buf[0];
-  if (isBitmap)
+  if (type == DRAW_TYPE_BITMAP)
   {
     log_i("copy bitmap.");
     int i = w * h;
@@ -56,7 +79,7 @@ static void queueDrawTask(uint32_t x, uint32_t y, uint32_t w, uint32_t h, bool i
       *p++ = *d++;
     }
   }
-  else
+  else if (type == DRAW_TYPE_FILL)
   {
     *p = *d;
   }
@@ -78,10 +101,14 @@ static void draw_task(void *arg)
   while (xQueueReceive(_xqh, &dd, portMAX_DELAY))
   {
     log_i("draw_task work start: x: %d, y: %d, w: %d, h: %d.", dd->x, dd->y, dd->w, dd->h);
-    if (dd->isBitmap)
+    if (dd->type == DRAW_TYPE_BITMAP)
     {
       gfx->draw16bitBeRGBBitmap(dd->x, dd->y, &dd->buf[0], dd->w, dd->h);
     }
+    else if (dd->type == DRAW_TYPE_COPY)
+    {
+      gfx->copyRect(dd->src_x, dd->src_y, dd->x, dd->y, dd->w, dd->h);
+    }
     else
     {
       gfx->fillRect(dd->x, dd->y, dd->w, dd->h, dd->buf[0]);
@@ -129,6 +156,10 @@ void draw_task_setup()
 
 #endif
 
+#define VNC_GFX_PENDING_NONE 0
+#define VNC_GFX_PENDING_FILL 1
+#define VNC_GFX_PENDING_BITMAP 2
+
 class VNC_GFX : public VNCdisplay
 {
 public:
@@ -137,9 +168,19 @@ public:
     _gfx = gfx;
   }
 
+  ~VNC_GFX()
+  {
+    if (_buf)
+    {
+      free(_buf);
+    }
+  }
+
+  // CopyRect needs a display that keeps its own framebuffer, e.g. Arduino_RGB_Display or Arduino_Canvas,
+  // a zero sized copy only asks whether it can
   bool hasCopyRect(void)
   {
-    return false;
+    return _gfx->copyRect(0, 0, 0, 0, 0, 0);
   }
 
   uint32_t getHeight(void)
@@ -153,24 +194,130 @@ public:
 
   void draw_area(uint32_t x, uint32_t y, uint32_t w, uint32_t h, uint8_t *data)
   {
-// DEBUG_VNC("draw_area(%d, %d, %d, %d, data)\n", x, y, w, h);
-#ifdef SEPARATE_DRAW_TASK
-    queueDrawTask(x, y, w, h, true, (uint16_t *)data);
-#else
-    // _gfx->draw16bitBeRGBBitmap(x, y, (uint16_t *)data, w, h);
-    _gfx->draw16bitRGBBitmap(x, y, (uint16_t *)data, w, h);
-#endif
+    // DEBUG_VNC("draw_area(%d, %d, %d, %d, data)\n", x, y, w, h);
+    gfx_rect_t r = {(int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h};
+    uint16_t *d = (uint16_t *)data;
+    startUpdate();
+
+    if ((_pending != VNC_GFX_PENDING_NONE) && contains(&r, &_p))
+    {
+      _pending = VNC_GFX_PENDING_NONE; // completely overdrawn
+    }
+    if (contains(&_p, &r) && toBitmap())
+    {
+      for (int16_t j = 0; j < r.h; ++j)
+      {
+        memcpy(_buf + ((int32_t)(r.y - _p.y + j) * _p.w) + (r.x - _p.x), d + ((int32_t)j * r.w), r.w * 2);
+      }
+      return;
+    }
+    if (join(&r, d, 0))
+    {
+      return;
+    }
+
+    drawPending();
+    if (stage(&r))
+    {
+      memcpy(_buf, d, (int32_t)r.w * r.h * 2);
+      _p = r;
+      _pending = VNC_GFX_PENDING_BITMAP;
+    }
+    else
+    {
+      drawBitmap(&r, d);
+    }
   }
 
   void draw_rect(uint32_t x, uint32_t y, uint32_t w, uint32_t h, uint16_t color)
   {
     // DEBUG_VNC("draw_rect(%d, %d, %d, %d, color)\n", x, y, w, h);
     // MSB_16_SET(color, color);
+    gfx_rect_t r = {(int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h};
+    startUpdate();
+
+    if (_pending == VNC_GFX_PENDING_FILL)
+    {
+      if ((color == _color) && contains(&_p, &r))
+      {
+        return;
+      }
+      if (contains(&r, &_p))
+      {
+        _p = r;
+        _color = color;
+        return;
+      }
+      if ((color == _color) && unionIsRect(&_p, &r))
+      {
+        int16_t x2 = max(_p.x + _p.w, r.x + r.w);
+        int16_t y2 = max(_p.y + _p.h, r.y + r.h);
+        _p.x = min(_p.x, r.x);
+        _p.y = min(_p.y, r.y);
+        _p.w = x2 - _p.x;
+        _p.h = y2 - _p.y;
+        return;
+      }
+    }
+    else if ((_pending == VNC_GFX_PENDING_BITMAP) && contains(&r, &_p))
+    {
+      _pending = VNC_GFX_PENDING_NONE;
+    }
+    // e.g. a Hextile or RRE subrect on its background
+    if (contains(&_p, &r) && toBitmap())
+    {
+      fillBuf(_buf + ((int32_t)(r.y - _p.y) * _p.w) + (r.x - _p.x), _p.w, r.w, r.h, color);
+      return;
+    }
+    if (join(&r, nullptr, color))
+    {
+      return;
+    }
+
+    drawPending();
+    _p = r;
+    _color = color;
+    _pending = VNC_GFX_PENDING_FILL;
+  }
+
+  void copy_rect(uint32_t src_x, uint32_t src_y, uint32_t dest_x, uint32_t dest_y, uint32_t w, uint32_t h)
+  {
+    // DEBUG_VNC("copy_rect(%d, %d, %d, %d, %d, %d)\n", src_x, src_y, dest_x, dest_y, w, h);
+    startUpdate();
+    drawPending(); // the source may still be pending
 #ifdef SEPARATE_DRAW_TASK
-    queueDrawTask(x, y, w, h, false, &color);
+    queueDrawTask(dest_x, dest_y, w, h, DRAW_TYPE_COPY, nullptr, src_x, src_y);
 #else
-    _gfx->fillRect(x, y, w, h, color);
+    _gfx->copyRect(src_x, src_y, dest_x, dest_y, w, h);
 #endif
+    ++_stats.copies;
+  }
+
+  // Draw whatever is still being merged and close the update, call after each vnc.loop()
+  void flush()
+  {
+    drawPending();
+    if (_update_start_us)
+    {
+      uint32_t latency = micros() - _update_start_us;
+      _stats.latency_sum_us += latency;
+      if (latency > _stats.latency_max_us)
+      {
+        _stats.latency_max_us = latency;
+      }
+      ++_stats.updates;
+      _update_start_us = 0;
+    }
+  }
+
+  void getStats(vnc_gfx_stats_t *stats)
+  {
+    *stats = _stats;
+  }
+
+  void resetStats()
+  {
+    memset(&_stats, 0, sizeof(_stats));
   }
 
   void vnc_options_override(dfb_vnc_options *opt)
@@ -179,7 +326,181 @@ public:
   }
 
 private:
+  static bool contains(const gfx_rect_t *a, const gfx_rect_t *b)
+  {
+    return (b->x >= a->x) && (b->y >= a->y) && ((b->x + b->w) <= (a->x + a->w)) && ((b->y + b->h) <= (a->y + a->h));
+  }
+
+  // touching or overlapping along a whole shared edge
+  static bool unionIsRect(const gfx_rect_t *a, const gfx_rect_t *b)
+  {
+    if ((a->x == b->x) && (a->w == b->w))
+    {
+      return (b->y <= (a->y + a->h)) && (a->y <= (b->y + b->h));
+    }
+    if ((a->y == b->y) && (a->h == b->h))
+    {
+      return (b->x <= (a->x + a->w)) && (a->x <= (b->x + b->w));
+    }
+    return false;
+  }
+
+  static void fillBuf(uint16_t *p, int16_t stride, int16_t w, int16_t h, uint16_t color)
+  {
+    while (h--)
+    {
+      for (int16_t i = 0; i < w; ++i)
+      {
+        p[i] = color;
+      }
+      p += stride;
+    }
+  }
+
+  bool stage(const gfx_rect_t *r)
+  {
+    int32_t pixels = (int32_t)r->w * r->h;
+    if ((VNC_GFX_MERGE_PIXELS == 0) || (pixels > VNC_GFX_MERGE_PIXELS))
+    {
+      return false;
+    }
+#ifdef SEPARATE_DRAW_TASK
+    if (pixels > FB_SIZE) // merged rects are copied into one draw buffer each
+    {
+      return false;
+    }
+#endif
+    if (!_buf)
+    {
+      _buf = (uint16_t *)malloc(VNC_GFX_MERGE_PIXELS * 2);
+    }
+    return _buf;
+  }
+
+  // Turn a pending fill into staged pixels so other rects can be drawn into it
+  bool toBitmap()
+  {
+    if (_pending == VNC_GFX_PENDING_FILL)
+    {
+      if (!stage(&_p))
+      {
+        return false;
+      }
+      fillBuf(_buf, _p.w, _p.w, _p.h, _color);
+      _pending = VNC_GFX_PENDING_BITMAP;
+    }
+    return _pending == VNC_GFX_PENDING_BITMAP;
+  }
+
+  // Append r right of or below the pending rect, data nullptr for a fill
+  bool join(const gfx_rect_t *r, const uint16_t *data, uint16_t color)
+  {
+    if (_pending == VNC_GFX_PENDING_NONE)
+    {
+      return false;
+    }
+    bool below = (r->x == _p.x) && (r->w == _p.w) && (r->y == (_p.y + _p.h));
+    bool right = (r->y == _p.y) && (r->h == _p.h) && (r->x == (_p.x + _p.w));
+    if (!(below || right))
+    {
+      return false;
+    }
+    gfx_rect_t n = _p;
+    if (below)
+    {
+      n.h += r->h;
+    }
+    else
+    {
+      n.w += r->w;
+    }
+    if (!stage(&n))
+    {
+      return false;
+    }
+
+    if (_pending == VNC_GFX_PENDING_FILL)
+    {
+      fillBuf(_buf, n.w, _p.w, _p.h, _color);
+    }
+    else if (right)
+    {
+      // widen the rows in place, last row first
+      for (int16_t j = _p.h - 1; j > 0; --j)
+      {
+        memmove(_buf + ((int32_t)j * n.w), _buf + ((int32_t)j * _p.w), _p.w * 2);
+      }
+    }
+
+    uint16_t *dst = below ? (_buf + ((int32_t)_p.h * n.w)) : (_buf + _p.w);
+    if (data)
+    {
+      for (int16_t j = 0; j < r->h; ++j)
+      {
+        memcpy(dst + ((int32_t)j * n.w), data + ((int32_t)j * r->w), r->w * 2);
+      }
+    }
+    else
+    {
+      fillBuf(dst, n.w, r->w, r->h, color);
+    }
+    _p = n;
+    _pending = VNC_GFX_PENDING_BITMAP;
+    return true;
+  }
+
+  void drawBitmap(const gfx_rect_t *r, uint16_t *data)
+  {
+#ifdef SEPARATE_DRAW_TASK
+    queueDrawTask(r->x, r->y, r->w, r->h, DRAW_TYPE_BITMAP, data);
+#else
+    // _gfx->draw16bitBeRGBBitmap(r->x, r->y, data, r->w, r->h);
+    _gfx->draw16bitRGBBitmap(r->x, r->y, data, r->w, r->h);
+#endif
+    ++_stats.rects_drawn;
+  }
+
+  void drawFill(const gfx_rect_t *r, uint16_t color)
+  {
+#ifdef SEPARATE_DRAW_TASK
+    queueDrawTask(r->x, r->y, r->w, r->h, DRAW_TYPE_FILL, &color);
+#else
+    _gfx->fillRect(r->x, r->y, r->w, r->h, color);
+#endif
+    ++_stats.rects_drawn;
+  }
+
+  void drawPending()
+  {
+    if (_pending == VNC_GFX_PENDING_FILL)
+    {
+      drawFill(&_p, _color);
+    }
+    else if (_pending == VNC_GFX_PENDING_BITMAP)
+    {
+      drawBitmap(&_p, _buf);
+    }
+    _pending = VNC_GFX_PENDING_NONE;
+  }
+
+  void startUpdate()
+  {
+    if (!_update_start_us)
+    {
+      _update_start_us = micros() | 1; // never 0 while an update is open
+    }
+    ++_stats.rects_in;
+  }
+
   Arduino_GFX *_gfx;
+
+  uint16_t *_buf = nullptr; // staged pixels of a pending bitmap, rows packed at _p.w
+  gfx_rect_t _p = {0, 0, 0, 0};
+  uint8_t _pending = VNC_GFX_PENDING_NONE;
+  uint16_t _color;
+
+  vnc_gfx_stats_t _stats = {};
+  uint32_t _update_start_us = 0;
 };
 
 #endif /* _VNC_GFX_H_ */
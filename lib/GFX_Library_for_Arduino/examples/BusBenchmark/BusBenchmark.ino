@@ -0,0 +1,136 @@
+/*******************************************************************************
+ * Data bus throughput benchmark
+ * Times writePixels(), writeRepeat() and writeBytes() for a 240x320 frame on
+ * Arduino_HWSPI. Only the paths that go through the staging buffer are
+ * repeated for each size passed to setBufferSize(): writeRepeat() and the
+ * staged writePixels(). On ESP32 writePixels() only stages sources that are
+ * not word aligned, so the sweep feeds it one; aligned writePixels() and
+ * writeBytes() send straight from the source and are timed once.
+ * The bus clocks data out whether or not a display is connected, results are
+ * printed to Serial.
+ * Default pins follow DF_GFX_* in Arduino_GFX_Library.h, see HelloWorld.
+ ******************************************************************************/
+#include <Arduino_GFX_Library.h>
+
+#define BENCH_W 240
+#define BENCH_H 320
+#define BENCH_ROUNDS 5
+#define BENCH_SPEED 40000000
+
+#if defined(ESP32)
+Arduino_HWSPI *bus = new Arduino_HWSPI(DF_GFX_DC, DF_GFX_CS, DF_GFX_SCK, DF_GFX_MOSI, DF_GFX_MISO);
+#else
+Arduino_HWSPI *bus = new Arduino_HWSPI(DF_GFX_DC, DF_GFX_CS);
+#endif
+
+static const uint32_t buffer_sizes[] = {32, 64, 128, 256, 512, 1024};
+static uint16_t *line;
+static uint16_t *line_staged; // not word aligned on ESP32, see header
+
+static void print_result(const char *name, uint32_t us)
+{
+  uint32_t bytes = (uint32_t)BENCH_W * BENCH_H * 2;
+  Serial.printf("  %-12s %8lu us %7.2f MB/s %6.1f fps\n",
+                name, (unsigned long)us, (float)bytes / us, 1000000.0 / us);
+}
+
+static uint32_t bench_write_pixels(uint16_t *src)
+{
+  uint32_t start = micros();
+  for (int i = 0; i < BENCH_ROUNDS; ++i)
+  {
+    bus->beginWrite();
+    for (int16_t y = 0; y < BENCH_H; ++y)
+    {
+      bus->writePixels(src, BENCH_W);
+    }
+    bus->endWrite();
+  }
+  return (micros() - start) / BENCH_ROUNDS;
+}
+
+static void bench_direct()
+{
+  Serial.println("without staging buffer:");
+#if defined(ESP32)
+  // word aligned little endian pixels, swapped by the core on the way into the FIFO
+  print_result("writePixels", bench_write_pixels(line));
+#endif
+
+  // already in bus byte order, sent straight from the source
+  uint32_t start = micros();
+  for (int i = 0; i < BENCH_ROUNDS; ++i)
+  {
+    bus->beginWrite();
+    for (int16_t y = 0; y < BENCH_H; ++y)
+    {
+      bus->writeBytes((uint8_t *)line, BENCH_W * 2);
+    }
+    bus->endWrite();
+  }
+  print_result("writeBytes", (micros() - start) / BENCH_ROUNDS);
+}
+
+static void bench_staged(uint32_t buffer_pixels)
+{
+  if (!bus->setBufferSize(buffer_pixels))
+  {
+    Serial.printf("buffer %lu pixels: allocation failed!\n", (unsigned long)buffer_pixels);
+    return;
+  }
+  Serial.printf("buffer %lu pixels:\n", (unsigned long)bus->getBufferSize());
+
+  // little endian pixels, byte swapped through the staging buffer
+  print_result("writePixels", bench_write_pixels(line_staged));
+
+  uint32_t start = micros();
+  for (int i = 0; i < BENCH_ROUNDS; ++i)
+  {
+    bus->beginWrite();
+    bus->writeRepeat(0xF81F, (uint32_t)BENCH_W * BENCH_H);
+    bus->endWrite();
+  }
+  print_result("writeRepeat", (micros() - start) / BENCH_ROUNDS);
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  // Serial.setDebugOutput(true);
+  // while(!Serial);
+  Serial.println("Arduino_GFX data bus benchmark");
+
+  if (!bus->begin(BENCH_SPEED))
+  {
+    Serial.println("bus->begin() failed!");
+    return;
+  }
+
+  // one spare pixel so line_staged can start half a word in
+  line = (uint16_t *)malloc((BENCH_W + 1) * 2);
+  if (!line)
+  {
+    Serial.println("Line buffer allocation failed!");
+    return;
+  }
+  for (int16_t x = 0; x <= BENCH_W; ++x)
+  {
+    line[x] = x * 0x0841;
+  }
+#if defined(ESP32)
+  line_staged = line + 1;
+#else
+  line_staged = line;
+#endif
+
+  bench_direct();
+  for (size_t i = 0; i < sizeof(buffer_sizes) / sizeof(buffer_sizes[0]); ++i)
+  {
+    bench_staged(buffer_sizes[i]);
+  }
+}
+
+void loop()
+{
+  delay(1000);
+}
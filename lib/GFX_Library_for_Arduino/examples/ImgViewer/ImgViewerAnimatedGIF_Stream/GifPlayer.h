@@ -0,0 +1,672 @@
+/*******************************************************************************
+ * Streaming GIF player
+ *
+ * Plays an animated GIF straight to an Arduino_GFX, one frame per call:
+ * - the source is a file read through a large read-ahead buffer, or a GIF
+ *   already in memory (PSRAM, flash mapped array) used in place
+ * - LZW strings are written backwards straight into the frame buffer using a
+ *   string length table, no per pixel stack
+ * - only the frame sub-rectangle is decoded and sent to the display, pixels of
+ *   a transparent frame are sent as opaque runs so unchanged areas stay as is
+ * - disposal 2 (restore to background) clears the previous frame rectangle,
+ *   disposal 3 (restore to previous) would need a copy of the screen and is
+ *   treated as disposal 1 (leave in place)
+ * - each frame reports its decode and draw time
+ ******************************************************************************/
+#pragma once
+
+/* Wio Terminal */
+#if defined(ARDUINO_ARCH_SAMD) && defined(SEEED_GROVE_UI_WIRELESS)
+#include <Seeed_FS.h>
+#elif defined(ESP32) || defined(ESP8266)
+#include <FS.h>
+#else
+#include <SD.h>
+#endif
+
+// read-ahead buffer for file sources, larger buffers mean fewer file system calls
+#ifndef GIF_PLAYER_BUF_SIZE
+#define GIF_PLAYER_BUF_SIZE 8192
+#endif
+
+#define GIF_LZW_MAX_CODES 4096
+#define GIF_LZW_NO_CODE 0xFFFF
+
+#define GIF_DISPOSAL_NONE 0
+#define GIF_DISPOSAL_KEEP 1
+#define GIF_DISPOSAL_BACKGROUND 2
+#define GIF_DISPOSAL_PREVIOUS 3
+
+typedef struct
+{
+    uint16_t x, y, w, h; // frame rectangle in the GIF logical screen
+    uint16_t delay_ms;
+    uint8_t disposal;
+    bool transparent;
+    bool interlaced;
+    uint32_t decode_us;
+    uint32_t draw_us;
+} gif_frame_info_t;
+
+class GifPlayer
+{
+public:
+    ~GifPlayer()
+    {
+        close();
+    }
+
+    bool open(File *fd)
+    {
+        close();
+        _fd = fd;
+        _read_buf = (uint8_t *)malloc(GIF_PLAYER_BUF_SIZE);
+        if (!_read_buf)
+        {
+            Serial.println(F("read buffer malloc failed!"));
+            return false;
+        }
+        _buf = _read_buf;
+        return openCommon();
+    }
+
+    // data must stay valid until close()
+    bool open(const uint8_t *data, size_t len)
+    {
+        close();
+        _buf = data;
+        _buf_len = len;
+        return openCommon();
+    }
+
+    void close()
+    {
+        if (_fd)
+        {
+            _fd->close();
+            _fd = nullptr;
+        }
+        free(_read_buf);
+        free(_lzw_prefix);
+        free(_pixels);
+        free(_row);
+        _read_buf = nullptr;
+        _lzw_prefix = nullptr;
+        _pixels = nullptr;
+        _row = nullptr;
+        _buf = nullptr;
+        _buf_len = 0;
+        _buf_idx = 0;
+        _buf_pos = 0;
+        _eof = false;
+    }
+
+    uint16_t width() { return _width; }
+    uint16_t height() { return _height; }
+    uint16_t loopCount() { return _loop_count; }
+
+    // Restore to background fills with this color, default is the GIF background color
+    void setBackground(uint16_t color) { _bg_color = color; }
+
+    /* Decode and draw the next frame with the logical screen at (x, y).
+     * Return 1 if drew a frame; 0 if got GIF trailer; -1 if error. */
+    int8_t drawFrame(Arduino_GFX *gfx, int16_t x, int16_t y, gif_frame_info_t *info)
+    {
+        while (1)
+        {
+            uint8_t sep = readByte();
+            if (_eof)
+            {
+                return 0; // truncated file, treat as trailer
+            }
+            if (sep == ',')
+            {
+                break;
+            }
+            if (sep == ';')
+            {
+                return 0;
+            }
+            if (sep == '!')
+            {
+                readExtension();
+            }
+            else if (sep != 0)
+            {
+                Serial.print(F("Read sep: ["));
+                Serial.print(sep);
+                Serial.println(F("]."));
+                return -1;
+            }
+        }
+
+        uint16_t fx = read16();
+        uint16_t fy = read16();
+        uint16_t fw = read16();
+        uint16_t fh = read16();
+        uint8_t flags = readByte();
+        uint16_t *palette = _gct;
+        if (flags & 0x80)
+        {
+            readPalette(_lct, 1 << ((flags & 0x07) + 1));
+            palette = _lct;
+        }
+
+        info->x = fx;
+        info->y = fy;
+        info->w = fw;
+        info->h = fh;
+        info->delay_ms = _gce_delay * 10;
+        info->disposal = _gce_disposal;
+        info->transparent = _gce_transparent;
+        info->interlaced = flags & 0x40;
+
+        uint32_t t = micros();
+        if (((uint32_t)fw * fh) > ((uint32_t)_width * _height))
+        {
+            Serial.println(F("frame larger than the logical screen"));
+            return -1;
+        }
+        if (!decodeImage((uint32_t)fw * fh))
+        {
+            return -1;
+        }
+        info->decode_us = micros() - t;
+
+        t = micros();
+        disposePrevious(gfx, x, y, fx, fy, fw, fh);
+        drawImage(gfx, x, y, palette, info);
+        info->draw_us = micros() - t;
+
+        _prev_x = fx;
+        _prev_y = fy;
+        _prev_w = fw;
+        _prev_h = fh;
+        _prev_disposal = _gce_disposal;
+        _gce_delay = 0;
+        _gce_disposal = GIF_DISPOSAL_NONE;
+        _gce_transparent = false;
+        return 1;
+    }
+
+    void rewind()
+    {
+        if (!_fd)
+        {
+            _buf_idx = _anim_start;
+        }
+        else if ((_anim_start >= _buf_pos) && (_anim_start < (_buf_pos + _buf_len)))
+        {
+            _buf_idx = _anim_start - _buf_pos;
+        }
+        else
+        {
+#if defined(ESP32) || defined(ESP8266)
+            _fd->seek(_anim_start, SeekSet);
+#else
+            _fd->seek(_anim_start);
+#endif
+            _buf_pos = _anim_start;
+            _buf_len = 0;
+            _buf_idx = 0;
+        }
+        _eof = false;
+        _first_frame = true;
+        _prev_disposal = GIF_DISPOSAL_NONE;
+    }
+
+private:
+    bool openCommon()
+    {
+        uint8_t sig[6];
+        for (uint8_t i = 0; i < 6; ++i)
+        {
+            sig[i] = readByte();
+        }
+        if ((memcmp(sig, "GIF89a", 6) != 0) && (memcmp(sig, "GIF87a", 6) != 0))
+        {
+            Serial.println(F("invalid signature"));
+            return false;
+        }
+        _width = read16();
+        _height = read16();
+        uint8_t flags = readByte();
+        uint8_t bgindex = readByte();
+        readByte(); // aspect ratio
+        if (flags & 0x80)
+        {
+            readPalette(_gct, 1 << ((flags & 0x07) + 1));
+        }
+        else
+        {
+            memset(_gct, 0, sizeof(_gct));
+        }
+        _bg_color = _gct[bgindex];
+        if (_eof || (_width == 0) || (_height == 0))
+        {
+            Serial.println(F("invalid header"));
+            return false;
+        }
+
+        // prefix and length tables are uint16_t, suffix and first byte tables follow them
+        _lzw_prefix = (uint16_t *)malloc(GIF_LZW_MAX_CODES * (2 + 2 + 1 + 1));
+        _pixels = (uint8_t *)malloc((uint32_t)_width * _height);
+        _row = (uint16_t *)malloc(_width * 2);
+        if ((!_lzw_prefix) || (!_pixels) || (!_row))
+        {
+            Serial.println(F("GIF buffers malloc failed!"));
+            close();
+            return false;
+        }
+        _lzw_len = _lzw_prefix + GIF_LZW_MAX_CODES;
+        _lzw_suffix = (uint8_t *)(_lzw_len + GIF_LZW_MAX_CODES);
+        _lzw_first = _lzw_suffix + GIF_LZW_MAX_CODES;
+
+        _anim_start = _buf_pos + _buf_idx;
+        _loop_count = 0;
+        _first_frame = true;
+        _prev_disposal = GIF_DISPOSAL_NONE;
+        _gce_delay = 0;
+        _gce_disposal = GIF_DISPOSAL_NONE;
+        _gce_transparent = false;
+        return true;
+    }
+
+    bool refill()
+    {
+        if (!_fd)
+        {
+            return false;
+        }
+        _buf_pos += _buf_len;
+        int32_t len = _fd->read(_read_buf, GIF_PLAYER_BUF_SIZE);
+        _buf_len = (len > 0) ? len : 0;
+        _buf_idx = 0;
+        return _buf_len > 0;
+    }
+
+    inline uint8_t readByte()
+    {
+        if ((_buf_idx >= _buf_len) && (!refill()))
+        {
+            _eof = true;
+            return 0;
+        }
+        return _buf[_buf_idx++];
+    }
+
+    uint16_t read16()
+    {
+        uint16_t lo = readByte();
+        return lo | ((uint16_t)readByte() << 8);
+    }
+
+    void skip(uint32_t len)
+    {
+        while (len)
+        {
+            uint32_t avail = _buf_len - _buf_idx;
+            if (avail >= len)
+            {
+                _buf_idx += len;
+                return;
+            }
+            len -= avail;
+            _buf_idx = _buf_len;
+            if (!refill())
+            {
+                _eof = true;
+                return;
+            }
+        }
+    }
+
+    void skipSubBlocks()
+    {
+        uint8_t len;
+        do
+        {
+            len = readByte();
+            skip(len);
+        } while (len && (!_eof));
+    }
+
+    void readPalette(uint16_t *dest, int16_t num_colors)
+    {
+        uint8_t r, g, b;
+        for (int16_t i = 0; i < num_colors; i++)
+        {
+            r = readByte();
+            g = readByte();
+            b = readByte();
+            dest[i] = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | ((b & 0xF8) >> 3);
+        }
+        for (int16_t i = num_colors; i < 256; i++)
+        {
+            dest[i] = 0;
+        }
+    }
+
+    void readExtension()
+    {
+        uint8_t label = readByte();
+        if (label == 0xF9) // graphic control
+        {
+            uint8_t len = readByte();
+            if (len >= 4)
+            {
+                uint8_t flags = readByte();
+                _gce_delay = read16();
+                _gce_tindex = readByte();
+                _gce_disposal = (flags >> 2) & 0x07;
+                _gce_transparent = flags & 0x01;
+                len -= 4;
+            }
+            skip(len); // a short block carries no usable fields, keep the previous ones
+            skipSubBlocks();
+        }
+        else if (label == 0xFF) // application
+        {
+            uint8_t len = readByte();
+            char id[11];
+            for (uint8_t i = 0; i < 11; ++i)
+            {
+                id[i] = (i < len) ? readByte() : 0;
+            }
+            if (len > 11)
+            {
+                skip(len - 11);
+            }
+            if ((len == 11) && (memcmp(id, "NETSCAPE2.0", 11) == 0))
+            {
+                len = readByte();
+                if (len >= 3)
+                {
+                    readByte(); // sub-block id, always 1
+                    _loop_count = read16();
+                    skip(len - 3);
+                }
+                else
+                {
+                    skip(len);
+                }
+            }
+            skipSubBlocks();
+        }
+        else // comment, plain text
+        {
+            skipSubBlocks();
+        }
+    }
+
+    // Decode one image data block into _pixels, pixels in file order
+    bool decodeImage(uint32_t total)
+    {
+        uint8_t min_code_size = readByte();
+        if ((min_code_size < 2) || (min_code_size > 8))
+        {
+            Serial.println(F("invalid LZW code size"));
+            return false;
+        }
+        uint16_t clear = 1 << min_code_size;
+        uint16_t eoi = clear + 1;
+        for (uint16_t i = 0; i < clear; ++i)
+        {
+            _lzw_len[i] = 1;
+            _lzw_suffix[i] = i;
+            _lzw_first[i] = i;
+        }
+
+        uint8_t code_size = min_code_size + 1;
+        uint16_t code_mask = (1 << code_size) - 1;
+        uint16_t next_code = eoi + 1;
+        uint16_t prev = GIF_LZW_NO_CODE;
+        uint32_t bits = 0;
+        uint8_t nbits = 0;
+        uint8_t block_left = 0;
+        bool data_end = false;
+        uint8_t *out = _pixels;
+        uint8_t *out_end = _pixels + total;
+
+        while (1)
+        {
+            while (nbits < code_size)
+            {
+                if (block_left == 0)
+                {
+                    block_left = readByte();
+                    if ((block_left == 0) || _eof)
+                    {
+                        data_end = true; // no EOI code before the block terminator
+                        break;
+                    }
+                }
+                bits |= (uint32_t)readByte() << nbits;
+                nbits += 8;
+                --block_left;
+            }
+            if (data_end)
+            {
+                break;
+            }
+            uint16_t code = bits & code_mask;
+            bits >>= code_size;
+            nbits -= code_size;
+
+            if (code == clear)
+            {
+                code_size = min_code_size + 1;
+                code_mask = (1 << code_size) - 1;
+                next_code = eoi + 1;
+                prev = GIF_LZW_NO_CODE;
+                continue;
+            }
+            if (code == eoi)
+            {
+                break;
+            }
+
+            if (prev != GIF_LZW_NO_CODE)
+            {
+                if (code > next_code)
+                {
+                    Serial.println(F("invalid LZW code"));
+                    return false;
+                }
+                if (next_code < GIF_LZW_MAX_CODES)
+                {
+                    // the new string is prev plus the first byte of code, for code == next_code (KwKwK)
+                    // that byte is the first byte of prev
+                    _lzw_prefix[next_code] = prev;
+                    _lzw_suffix[next_code] = (code == next_code) ? _lzw_first[prev] : _lzw_first[code];
+                    _lzw_first[next_code] = _lzw_first[prev];
+                    _lzw_len[next_code] = _lzw_len[prev] + 1;
+                    ++next_code;
+                    if ((next_code == (1 << code_size)) && (code_size < 12))
+                    {
+                        ++code_size;
+                        code_mask = (1 << code_size) - 1;
+                    }
+                }
+                else if (code == next_code)
+                {
+                    Serial.println(F("invalid LZW code"));
+                    return false;
+                }
+            }
+            else if (code >= clear)
+            {
+                Serial.println(F("invalid LZW code"));
+                return false;
+            }
+            prev = code;
+
+            // write the string backwards from its last byte
+            uint16_t len = _lzw_len[code];
+            if ((out + len) > out_end)
+            {
+                while ((out + len) > out_end) // drop the overflowing tail
+                {
+                    code = _lzw_prefix[code];
+                    --len;
+                    if (len == 0)
+                    {
+                        break;
+                    }
+                }
+            }
+            uint8_t *p = out + len;
+            out = p;
+            while (len > 1)
+            {
+                *--p = _lzw_suffix[code];
+                code = _lzw_prefix[code];
+                --len;
+            }
+            if (len)
+            {
+                *--p = code;
+            }
+        }
+
+        if (out < out_end) // short data, leave the rest unchanged on screen when possible
+        {
+            memset(out, _gce_transparent ? _gce_tindex : 0, out_end - out);
+        }
+        if (!data_end)
+        {
+            skip(block_left);
+            skipSubBlocks();
+        }
+        return true;
+    }
+
+    // Row in the frame rectangle of the r-th decoded row
+    uint16_t interlacedRow(uint16_t r, uint16_t h)
+    {
+        uint16_t n = (h + 7) / 8;
+        if (r < n)
+        {
+            return r * 8;
+        }
+        r -= n;
+        n = (h + 3) / 8;
+        if (r < n)
+        {
+            return 4 + (r * 8);
+        }
+        r -= n;
+        n = (h + 1) / 4;
+        if (r < n)
+        {
+            return 2 + (r * 4);
+        }
+        r -= n;
+        return 1 + (r * 2);
+    }
+
+    void disposePrevious(Arduino_GFX *gfx, int16_t x, int16_t y, uint16_t fx, uint16_t fy, uint16_t fw, uint16_t fh)
+    {
+        if (_first_frame)
+        {
+            _first_frame = false;
+            if (_gce_transparent || (fx != 0) || (fy != 0) || (fw != _width) || (fh != _height))
+            {
+                gfx->fillRect(x, y, _width, _height, _bg_color);
+            }
+        }
+        else if (_prev_disposal == GIF_DISPOSAL_BACKGROUND)
+        {
+            if (_prev_x >= _width || _prev_y >= _height)
+            {
+                return;
+            }
+            gfx->fillRect(x + _prev_x, y + _prev_y,
+                          min(_prev_w, (uint16_t)(_width - _prev_x)), min(_prev_h, (uint16_t)(_height - _prev_y)),
+                          _bg_color);
+        }
+    }
+
+    void drawImage(Arduino_GFX *gfx, int16_t x, int16_t y, uint16_t *palette, gif_frame_info_t *info)
+    {
+        if ((info->x >= _width) || (info->y >= _height))
+        {
+            return;
+        }
+        int16_t dw = min(info->w, (uint16_t)(_width - info->x));
+        int16_t dh = min(info->h, (uint16_t)(_height - info->y));
+        x += info->x;
+        y += info->y;
+
+        if ((!info->transparent) && (!info->interlaced))
+        {
+            gfx->drawIndexedBitmap(x, y, _pixels, palette, dw, dh, info->w - dw);
+            return;
+        }
+
+        uint8_t *src = _pixels;
+        for (uint16_t r = 0; r < info->h; ++r, src += info->w)
+        {
+            uint16_t row = info->interlaced ? interlacedRow(r, info->h) : r;
+            if (row >= dh)
+            {
+                continue;
+            }
+            if (!info->transparent)
+            {
+                gfx->drawIndexedBitmap(x, y + row, src, palette, dw, 1);
+                continue;
+            }
+            // send each run of opaque pixels as its own bitmap
+            int16_t i = 0;
+            while (i < dw)
+            {
+                while ((i < dw) && (src[i] == _gce_tindex))
+                {
+                    ++i;
+                }
+                int16_t start = i;
+                while ((i < dw) && (src[i] != _gce_tindex))
+                {
+                    _row[i - start] = palette[src[i]];
+                    ++i;
+                }
+                if (i > start)
+                {
+                    gfx->draw16bitRGBBitmap(x + start, y + row, _row, i - start, 1);
+                }
+            }
+        }
+    }
+
+    File *_fd = nullptr;
+    uint8_t *_read_buf = nullptr;
+    const uint8_t *_buf = nullptr;
+    uint32_t _buf_len = 0;
+    uint32_t _buf_idx = 0;
+    uint32_t _buf_pos = 0; // file offset of _buf[0]
+    uint32_t _anim_start = 0;
+    bool _eof = false;
+
+    uint16_t _width = 0, _height = 0;
+    uint16_t _loop_count = 0;
+    uint16_t _gct[256];
+    uint16_t _lct[256];
+    uint16_t _bg_color = 0;
+
+    uint16_t _gce_delay = 0;
+    uint8_t _gce_tindex = 0;
+    uint8_t _gce_disposal = GIF_DISPOSAL_NONE;
+    bool _gce_transparent = false;
+
+    bool _first_frame = true;
+    uint8_t _prev_disposal = GIF_DISPOSAL_NONE;
+    uint16_t _prev_x = 0, _prev_y = 0, _prev_w = 0, _prev_h = 0;
+
+    uint16_t *_lzw_prefix = nullptr;
+    uint16_t *_lzw_len = nullptr;
+    uint8_t *_lzw_suffix = nullptr;
+    uint8_t *_lzw_first = nullptr;
+    uint8_t *_pixels = nullptr;
+    uint16_t *_row = nullptr;
+};
@@ -0,0 +1,272 @@
+/*******************************************************************************
+ * Animated GIF Image Viewer, streaming player
+ * Plays an Animated GIF with GifPlayer: only the rectangle each frame changes
+ * is decoded and drawn, and every frame prints its decode and draw time.
+ * On ESP32 with PSRAM the whole file is loaded first and played from memory.
+ * Image Source: https://www.pexels.com/video/earth-rotating-video-856356/
+ * cropped: x: 598 y: 178 width: 720 height: 720 resized: 240x240
+ * optimized with ezgif.com
+ *
+ * Setup steps:
+ * 1. Change your LCD parameters in Arduino_GFX setting
+ * 2. Upload Animated GIF file
+ *   FFat (ESP32):
+ *     upload FFat (FatFS) data with ESP32 Sketch Data Upload:
+ *     ESP32: https://github.com/lorol/arduino-esp32fs-plugin
+ *   LittleFS (ESP32 / ESP8266 / Pico):
+ *     upload LittleFS data with ESP8266 LittleFS Data Upload:
+ *     ESP32: https://github.com/lorol/arduino-esp32fs-plugin
+ *     ESP8266: https://github.com/earlephilhower/arduino-esp8266littlefs-plugin
+ *     Pico: https://github.com/earlephilhower/arduino-pico-littlefs-plugin.git
+ *   SPIFFS (ESP32):
+ *     upload SPIFFS data with ESP32 Sketch Data Upload:
+ *     ESP32: https://github.com/lorol/arduino-esp32fs-plugin
+ *   SD:
+ *     Most Arduino system built-in support SD file system.
+ *     Wio Terminal require extra dependant Libraries:
+ *     - Seeed_Arduino_FS: https://github.com/Seeed-Studio/Seeed_Arduino_FS.git
+ *     - Seeed_Arduino_SFUD: https://github.com/Seeed-Studio/Seeed_Arduino_SFUD.git
+ ******************************************************************************/
+/* Wio Terminal */
+#if defined(ARDUINO_ARCH_SAMD) && defined(SEEED_GROVE_UI_WIRELESS)
+#define GIF_FILENAME "/ezgif.com-optimize.gif"
+#elif defined(TARGET_RP2040) || defined(PICO_RP2350)
+#define GIF_FILENAME "/ezgif.com-optimize.gif"
+#elif defined(ESP32)
+#define GIF_FILENAME "/ezgif.com-optimize.gif"
+#else
+#define GIF_FILENAME "/ezgif.com-resize.gif"
+#endif
+
+/*******************************************************************************
+ * Start of Arduino_GFX setting
+ *
+ * Arduino_GFX try to find the settings depends on selected board in Arduino IDE
+ * Or you can define the display dev kit not in the board list
+ * Defalult pin list for non display dev kit:
+ * Arduino Nano, Micro and more: CS:  9, DC:  8, RST:  7, BL:  6, SCK: 13, MOSI: 11, MISO: 12
+ * ESP32 various dev board     : CS:  5, DC: 27, RST: 33, BL: 22, SCK: 18, MOSI: 23, MISO: nil
+ * ESP32-C2/3 various dev board: CS:  7, DC:  2, RST:  1, BL:  3, SCK:  4, MOSI:  6, MISO: nil
+ * ESP32-C5 various dev board  : CS: 23, DC: 24, RST: 25, BL: 26, SCK: 10, MOSI:  8, MISO: nil
+ * ESP32-C6 various dev board  : CS: 18, DC: 22, RST: 23, BL: 15, SCK: 21, MOSI: 19, MISO: nil
+ * ESP32-H2 various dev board  : CS:  0, DC: 12, RST:  8, BL: 22, SCK: 10, MOSI: 25, MISO: nil
+ * ESP32-P4 various dev board  : CS: 26, DC: 27, RST: 25, BL: 24, SCK: 36, MOSI: 32, MISO: nil
+ * ESP32-S2 various dev board  : CS: 34, DC: 38, RST: 33, BL: 21, SCK: 36, MOSI: 35, MISO: nil
+ * ESP32-S3 various dev board  : CS: 40, DC: 41, RST: 42, BL: 48, SCK: 36, MOSI: 35, MISO: nil
+ * ESP8266 various dev board   : CS: 15, DC:  4, RST:  2, BL:  5, SCK: 14, MOSI: 13, MISO: 12
+ * Raspberry Pi Pico dev board : CS: 17, DC: 27, RST: 26, BL: 28, SCK: 18, MOSI: 19, MISO: 16
+ * RTL8720 BW16 old patch core : CS: 18, DC: 17, RST:  2, BL: 23, SCK: 19, MOSI: 21, MISO: 20
+ * RTL8720_BW16 Official core  : CS:  9, DC:  8, RST:  6, BL:  3, SCK: 10, MOSI: 12, MISO: 11
+ * RTL8722 dev board           : CS: 18, DC: 17, RST: 22, BL: 23, SCK: 13, MOSI: 11, MISO: 12
+ * RTL8722_mini dev board      : CS: 12, DC: 14, RST: 15, BL: 13, SCK: 11, MOSI:  9, MISO: 10
+ * Seeeduino XIAO dev board    : CS:  3, DC:  2, RST:  1, BL:  0, SCK:  8, MOSI: 10, MISO:  9
+ * Teensy 4.1 dev board        : CS: 39, DC: 41, RST: 40, BL: 22, SCK: 13, MOSI: 11, MISO: 12
+ ******************************************************************************/
+#include <Arduino_GFX_Library.h>
+
+#define GFX_BL DF_GFX_BL // default backlight pin, you may replace DF_GFX_BL to actual backlight pin
+
+/* More dev device declaration: https://github.com/moononournation/Arduino_GFX/wiki/Dev-Device-Declaration */
+#if defined(DISPLAY_DEV_KIT)
+Arduino_GFX *gfx = create_default_Arduino_GFX();
+#else /* !defined(DISPLAY_DEV_KIT) */
+
+/* More data bus class: https://github.com/moononournation/Arduino_GFX/wiki/Data-Bus-Class */
+Arduino_DataBus *bus = create_default_Arduino_DataBus();
+
+/* More display class: https://github.com/moononournation/Arduino_GFX/wiki/Display-Class */
+Arduino_GFX *gfx = new Arduino_ILI9341(bus, DF_GFX_RST, 3 /* rotation */, false /* IPS */);
+
+#endif /* !defined(DISPLAY_DEV_KIT) */
+/*******************************************************************************
+ * End of Arduino_GFX setting
+ ******************************************************************************/
+
+/* Wio Terminal */
+#if defined(ARDUINO_ARCH_SAMD) && defined(SEEED_GROVE_UI_WIRELESS)
+#include <Seeed_FS.h>
+#include <SD/Seeed_SD.h>
+#elif defined(TARGET_RP2040) || defined(PICO_RP2350)
+#include <LittleFS.h>
+#include <SD.h>
+#elif defined(ESP32)
+#include <FFat.h>
+#include <LittleFS.h>
+#include <SPIFFS.h>
+#include <SD.h>
+#include <SD_MMC.h>
+#elif defined(ESP8266)
+#include <LittleFS.h>
+#include <SD.h>
+#else
+#include <SD.h>
+#endif
+
+#include "GifPlayer.h"
+static GifPlayer gifPlayer;
+
+void setup()
+{
+#ifdef DEV_DEVICE_INIT
+  DEV_DEVICE_INIT();
+#endif
+
+  Serial.begin(115200);
+  // Serial.setDebugOutput(true);
+  // while(!Serial);
+  Serial.println("Arduino_GFX Animated GIF Image Viewer streaming example");
+
+  // Init Display
+  if (!gfx->begin())
+  {
+    Serial.println("gfx->begin() failed!");
+  }
+  gfx->fillScreen(RGB565_BLACK);
+
+#ifdef GFX_BL
+  pinMode(GFX_BL, OUTPUT);
+  digitalWrite(GFX_BL, HIGH);
+#endif
+
+/* Wio Terminal */
+#if defined(ARDUINO_ARCH_SAMD) && defined(SEEED_GROVE_UI_WIRELESS)
+  if (!SD.begin(SDCARD_SS_PIN, SDCARD_SPI, 4000000UL))
+#elif defined(TARGET_RP2040) || defined(PICO_RP2350)
+  if (!LittleFS.begin())
+  // if (!SD.begin(SS))
+#elif defined(ESP32)
+  // if (!FFat.begin())
+  if (!LittleFS.begin())
+  // if (!SPIFFS.begin())
+  // SPI.begin(12 /* CLK */, 13 /* D0/MISO */, 11 /* CMD/MOSI */);
+  // if (!SD.begin(10 /* CS */, SPI))
+  // pinMode(10 /* CS */, OUTPUT);
+  // digitalWrite(SD_CS, HIGH);
+  // SD_MMC.setPins(12 /* CLK */, 11 /* CMD/MOSI */, 13 /* D0/MISO */);
+  // if (!SD_MMC.begin("/root", true /* mode1bit */, false /* format_if_mount_failed */, SDMMC_FREQ_DEFAULT))
+  // SD_MMC.setPins(12 /* CLK */, 11 /* CMD/MOSI */, 13 /* D0/MISO */, 14 /* D1 */, 15 /* D2 */, 10 /* D3/CS */);
+  // if (!SD_MMC.begin("/root", false /* mode1bit */, false /* format_if_mount_failed */, SDMMC_FREQ_HIGHSPEED))
+#elif defined(ESP8266)
+  if (!LittleFS.begin())
+  // if (!SD.begin(SS))
+#else
+  if (!SD.begin())
+#endif
+  {
+    Serial.println(F("ERROR: File System Mount Failed!"));
+    gfx->println(F("ERROR: File System Mount Failed!"));
+  }
+}
+
+void loop()
+{
+/* Wio Terminal */
+#if defined(ARDUINO_ARCH_SAMD) && defined(SEEED_GROVE_UI_WIRELESS)
+  File gifFile = SD.open(GIF_FILENAME, "r");
+#elif defined(TARGET_RP2040) || defined(PICO_RP2350)
+  File gifFile = LittleFS.open(GIF_FILENAME, "r");
+  // File gifFile = SD.open(GIF_FILENAME, "r");
+#elif defined(ESP32)
+  // File gifFile = FFat.open(GIF_FILENAME, "r");
+  File gifFile = LittleFS.open(GIF_FILENAME, "r");
+  // File gifFile = SPIFFS.open(GIF_FILENAME, "r");
+  // File gifFile = SD.open(GIF_FILENAME, "r");
+#elif defined(ESP8266)
+  File gifFile = LittleFS.open(GIF_FILENAME, "r");
+  // File gifFile = SD.open(GIF_FILENAME, "r");
+#else
+  File gifFile = SD.open(GIF_FILENAME, FILE_READ);
+#endif
+
+  if (!gifFile || gifFile.isDirectory())
+  {
+    Serial.println(F("ERROR: open gifFile Failed!"));
+    gfx->println(F("ERROR: open gifFile Failed!"));
+    delay(1000);
+    return;
+  }
+
+  bool opened;
+  uint8_t *gifData = nullptr;
+#if defined(ESP32)
+  if (psramFound())
+  {
+    size_t len = gifFile.size();
+    gifData = (uint8_t *)ps_malloc(len);
+    if (gifData && (gifFile.read(gifData, len) != len))
+    {
+      free(gifData);
+      gifData = nullptr;
+    }
+  }
+#endif
+  if (gifData)
+  {
+    size_t len = gifFile.size();
+    gifFile.close();
+    opened = gifPlayer.open(gifData, len);
+  }
+  else
+  {
+    gifFile.seek(0);
+    opened = gifPlayer.open(&gifFile);
+  }
+
+  if (!opened)
+  {
+    Serial.println(F("gifPlayer.open() failed!"));
+  }
+  else
+  {
+    int16_t x = (gfx->width() - gifPlayer.width()) / 2;
+    int16_t y = (gfx->height() - gifPlayer.height()) / 2;
+
+    Serial.println(F("GIF video start"));
+    Serial.println(F("frame,x,y,w,h,disposal,decode_us,draw_us"));
+    gif_frame_info_t info;
+    int32_t start_ms = millis(), delay_until;
+    int32_t duration = 0, remain = 0;
+    uint32_t frames = 0, total_decode = 0, total_draw = 0;
+    int8_t res;
+    while ((res = gifPlayer.drawFrame(gfx, x, y, &info)) > 0)
+    {
+      Serial.printf("%lu,%u,%u,%u,%u,%u,%lu,%lu\n",
+                    (unsigned long)frames, info.x, info.y, info.w, info.h, info.disposal,
+                    (unsigned long)info.decode_us, (unsigned long)info.draw_us);
+      ++frames;
+      total_decode += info.decode_us;
+      total_draw += info.draw_us;
+
+      duration += info.delay_ms;
+      delay_until = start_ms + duration;
+      while (millis() < delay_until)
+      {
+        delay(1);
+        remain++;
+      }
+    }
+    if (res < 0)
+    {
+      Serial.println(F("ERROR: gifPlayer.drawFrame() failed!"));
+    }
+    Serial.println(F("GIF video end"));
+    Serial.print(F("Frames: "));
+    Serial.print(frames);
+    Serial.print(F(", decode: "));
+    Serial.print(total_decode / 1000);
+    Serial.print(F(" ms, draw: "));
+    Serial.print(total_draw / 1000);
+    Serial.println(F(" ms"));
+    Serial.print(F("Actual duration: "));
+    Serial.print(millis() - start_ms);
+    Serial.print(F(", expected duration: "));
+    Serial.print(duration);
+    Serial.print(F(", remain: "));
+    Serial.print(remain);
+    Serial.print(F(" ("));
+    Serial.print(100.0 * remain / duration);
+    Serial.println(F("%)"));
+  }
+  gifPlayer.close();
+  free(gifData);
+}
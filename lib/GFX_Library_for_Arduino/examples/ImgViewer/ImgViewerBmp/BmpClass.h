@@ -2,6 +2,9 @@
  * BMP Class
  *
  * Rewrite from: https://github.com/Jaycar-Electronics/Arduino-Picture-Frame.git
+ *
+ * Pixel rows are read many at a time into one block, converted with the
+ * Arduino_ImageStrip kernels and drawn in strips of GFX_IMAGE_STRIP_ROWS rows.
  ******************************************************************************/
 #ifndef _BMPCLASS_H_
 #define _BMPCLASS_H_
@@ -15,207 +18,199 @@
 #include <SD.h>
 #endif
 
-typedef void(BMP_DRAW_CALLBACK)(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h);
+#include <Arduino_GFX_Library.h>
+
+// file bytes read per f->read() call, rounded down to whole rows (at least one)
+#ifndef BMP_READ_BUF_SIZE
+#define BMP_READ_BUF_SIZE 8192
+#endif
 
 class BmpClass
 {
 public:
-    void draw(
-        File *f, BMP_DRAW_CALLBACK *bmpDrawCallback, bool useBigEndian,
+    bool draw(
+        File *f, Arduino_G *output, bool useBigEndian,
         int16_t x, int16_t y, int16_t widthLimit, int16_t heightLimit)
     {
-        _bmpDrawCallback = bmpDrawCallback;
         _useBigEndian = useBigEndian;
-        _heightLimit = heightLimit;
-
-        int16_t u, v;
-        uint32_t xend;
 
-        getbmpparms(f);
-
-        // validate bitmap
-        if ((bmtype == 19778) && (bmwidth > 0) && (bmheight > 0) && (bmbpp > 0))
+        if (!getbmpparms(f))
         {
-            // centre image
-            u = (widthLimit - bmwidth) / 2;
-            v = (heightLimit - bmheight) / 2;
-            u = (u < 0) ? x : x + u;
-            v = (v < 0) ? y : y + v;
-            xend = (bmwidth > widthLimit) ? widthLimit : bmwidth;
+            return false;
+        }
 
-            bmpRow = (uint16_t *)malloc(xend * 2);
-            if (!bmpRow)
-            {
-                Serial.println(F("bmpRow malloc failed."));
-            }
-            if (bmbpp < 9)
-            {
-                bmplt = (uint16_t *)malloc(bmpltsize * 2);
-                if (!bmplt)
-                {
-                    Serial.println(F("bmplt malloc failed."));
-                }
-                bmloadplt(f); // load palette if palettized
-                drawbmpal(f, u, v, xend);
-                free(bmplt);
-            }
-            else if (bmbpp == 16)
-            {
-                // TODO: bpp 16 should have 3 pixel types
-                drawbmRgb565(f, u, v, xend);
-            }
-            else
-            {
-                drawbmtrue(f, u, v, xend);
-            }
-            free(bmpRow);
+        // centre image
+        int16_t u = (widthLimit - (int16_t)bmwidth) / 2;
+        int16_t v = (heightLimit - (int16_t)bmheight) / 2;
+        u = (u < 0) ? x : x + u;
+        v = (v < 0) ? y : y + v;
+        int16_t xend = ((int16_t)bmwidth > widthLimit) ? widthLimit : bmwidth;
+        int16_t yend = ((int16_t)bmheight > heightLimit) ? heightLimit : bmheight;
+        if ((xend <= 0) || (yend <= 0))
+        {
+            return false;
         }
-    }
 
-private:
-    void bmloadplt(File *f)
-    {
-        byte r, g, b;
-        if (bmpltsize == 0)
+        bmbpl = ((bmbpp * bmwidth + 31) / 32) * 4; // bytes per line, due to 32bit chunks
+        int32_t rowsPerRead = BMP_READ_BUF_SIZE / bmbpl;
+        if (rowsPerRead < 1)
         {
-            bmpltsize = 1 << bmbpp; // load default palette size
+            rowsPerRead = 1;
         }
-        f->seek(54); // palette position in type 0x28 bitmaps
-        for (int16_t i = 0; i < bmpltsize; i++)
+        else if (rowsPerRead > yend)
         {
-            b = f->read();
-            g = f->read();
-            r = f->read();
-            f->read(); // dummy byte
-            bmplt[i] = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+            rowsPerRead = yend;
         }
-    }
 
-    void drawbmpal(File *f, int16_t u, int16_t v, uint32_t xend)
-    {
-        byte bmbitmask;
-        int16_t i, ystart, bmppb, p, d;
-        int16_t x, y;
-        uint16_t c;
-        bmbpl = ((bmbpp * bmwidth + 31) / 32) * 4; // bytes per line
-        bmppb = 8 / bmbpp;                         // pixels/byte
-        bmbitmask = ((1 << bmbpp) - 1);            // mask for each pixel
-        ystart = 0;
-        if (bmheight > _heightLimit)
+        bool ret = false;
+        Arduino_ImageStrip strip(output, xend);
+        uint8_t *readBuf = (uint8_t *)malloc(rowsPerRead * bmbpl); // rows stay 4-byte aligned for the kernels
+        bmplt = nullptr;
+        if ((!readBuf) || (!strip.begin()))
+        {
+            Serial.println(F("BMP buffer malloc failed."));
+        }
+        else if ((bmbpp <= 8) && (!bmloadplt(f)))
         {
-            ystart = bmheight - _heightLimit; // don't draw if it's outside screen
+            Serial.println(F("BMP palette load failed."));
         }
-        for (y = ystart; y < bmheight; y++)
-        {                                   // invert in calculation (y=0 is bottom)
-            f->seek(bmdataptr + y * bmbpl); // seek to start of line
-            x = 0;
-            p = 0;
-            while (x < xend)
+        else
+        {
+            // only the top yend image rows are drawn, bottom-up files start at the last of them
+            uint32_t skip = _topDown ? 0 : (bmheight - yend);
+            f->seek(bmdataptr + (skip * bmbpl));
+            strip.start(u, _topDown ? v : (v + yend - 1), !_topDown);
+
+            int16_t rows = yend;
+            while (rows > 0)
             {
-                if (p < 1)
+                int16_t n = (rows < rowsPerRead) ? rows : rowsPerRead;
+                if (f->read(readBuf, n * bmbpl) != (size_t)(n * bmbpl))
                 {
-                    d = f->read();
-                    p = bmppb;
+                    break;
                 }
-                d = d << bmbpp;
-                c = bmplt[(bmbitmask & (d >> 8))];
-                bmpRow[x] = (_useBigEndian) ? ((c >> 8) | (c << 8)) : c;
-
-                p--;
-                x++;
+                const uint8_t *src = readBuf;
+                for (int16_t i = 0; i < n; ++i)
+                {
+                    convertRow(src, strip.nextRow(), xend);
+                    src += bmbpl;
+                }
+                rows -= n;
             }
-            _bmpDrawCallback(u, v + bmheight - 1 - y, bmpRow, xend, 1);
+            strip.flush();
+            ret = (rows == 0);
+        }
+
+        if (bmplt)
+        {
+            free(bmplt);
         }
+        if (readBuf)
+        {
+            free(readBuf);
+        }
+        return ret;
     }
 
-    // draw 16-bit colour (RGB565) bitmap
-    void drawbmRgb565(File *f, int16_t u, int16_t v, uint32_t xend)
+private:
+    void convertRow(const uint8_t *src, uint16_t *dst, int16_t w)
     {
-        int16_t i, ystart;
-        uint32_t x, y;
-        byte lo, hi;
-        bmbpl = ((bmbpp * bmwidth + 31) / 32) * 4; // bytes per line, due to 32bit chunks
-        ystart = 0;
-        if (bmheight > _heightLimit)
+        switch (bmbpp)
         {
-            ystart = bmheight - _heightLimit; // don't draw if it's outside screen
-        }
-        Serial.println(xend);
-        for (y = ystart; y < bmheight; y++)
-        {                                     // invert in calculation (y=0 is bottom)
-            f->seek(bmdataptr + (y * bmbpl)); // seek at start of line
-            for (x = 0; x < xend; x++)
-            {
-                lo = f->read();
-                hi = f->read();
-                if (_useBigEndian)
-                {
-                    bmpRow[x] = hi | lo << 8;
-                }
-                else
-                {
-                    bmpRow[x] = lo | hi << 8;
-                }
-            }
-            _bmpDrawCallback(u, v + bmheight - 1 - y, bmpRow, xend, 1);
+        case 32:
+            gfx_bgrx8888_to_rgb565(src, dst, w, _useBigEndian);
+            break;
+        case 24:
+            gfx_bgr888_to_rgb565(src, dst, w, _useBigEndian);
+            break;
+        case 16:
+            // TODO: bpp 16 should have 3 pixel types
+            gfx_rgb565le_to_rgb565(src, dst, w, _useBigEndian);
+            break;
+        default:
+            gfx_indexed_to_rgb565(src, dst, w, bmbpp, bmplt);
+            break;
         }
     }
 
-    // draw true colour bitmap at (u,v) handles 24/32 not 16bpp yet
-    void drawbmtrue(File *f, int16_t u, int16_t v, uint32_t xend)
+    bool bmloadplt(File *f)
     {
-        int16_t i, ystart;
-        uint32_t x, y;
-        byte r, g, b;
-        bmbpl = ((bmbpp * bmwidth + 31) / 32) * 4; // bytes per line, due to 32bit chunks
-        ystart = 0;
-        if (bmheight > _heightLimit)
+        if (bmpltsize == 0)
         {
-            ystart = bmheight - _heightLimit; // don't draw if it's outside screen
+            bmpltsize = 1 << bmbpp; // load default palette size
         }
-        for (y = ystart; y < bmheight; y++)
-        {                                   // invert in calculation (y=0 is bottom)
-            f->seek(bmdataptr + y * bmbpl); // seek at start of line
-            for (x = 0; x < xend; x++)
+        // fill all (1 << bpp) entries so stray indices stay in range
+        bmplt = (uint16_t *)calloc(1 << bmbpp, 2);
+        uint8_t *raw = (uint8_t *)malloc(bmpltsize * 4);
+        bool ret = false;
+        if (bmplt && raw)
+        {
+            f->seek(14 + bmhdrsize); // palette follows the DIB header
+            if (f->read(raw, bmpltsize * 4) == bmpltsize * 4)
             {
-                b = f->read();
-                g = f->read();
-                r = f->read();
-                if (bmbpp == 32)
-                {
-                    f->read(); // dummy byte for 32bit
-                }
-                bmpRow[x] = (_useBigEndian) ? ((r & 0xf8) | (g >> 5) | ((g & 0x1c) << 11) | ((b & 0xf8) << 5)) : (((r & 0xf8) << 8) | ((g & 0xfc) << 3) | (b >> 3));
+                // B, G, R, dummy byte per entry
+                gfx_bgrx8888_to_rgb565(raw, bmplt, bmpltsize, _useBigEndian);
+                ret = true;
             }
-            _bmpDrawCallback(u, v + bmheight - 1 - y, bmpRow, xend, 1);
         }
+        if (raw)
+        {
+            free(raw);
+        }
+        return ret;
     }
 
-    void getbmpparms(File *f)
-    {               // load into globals as ints-some parameters are 32 bit, but we can't handle this size anyway
-        byte h[48]; // header is 54 bytes typically, but we don't need it all
-        int16_t i;
-        f->seek(0); // set start of file
-        for (i = 0; i < 48; i++)
+    bool getbmpparms(File *f)
+    {
+        uint8_t h[54]; // file header and the BITMAPINFOHEADER part of any DIB header
+        f->seek(0);    // set start of file
+        if (f->read(h, 54) != 54)
         {
-            h[i] = f->read(); // read header
+            return false;
         }
-        bmtype = h[0] + (h[1] << 8);      // offset 0 'BM'
-        bmdataptr = h[10] + (h[11] << 8); // offset 0xA pointer to image data
-        bmhdrsize = h[14] + (h[15] << 8); // dib header size (0x28 is usual)
-        // files may vary here, if !=28, unsupported type, put default values
+        bmtype = h[0] + (h[1] << 8);                                                       // offset 0 'BM'
+        bmdataptr = h[10] + (h[11] << 8) + ((uint32_t)h[12] << 16) + ((uint32_t)h[13] << 24); // offset 0xA pointer to image data
+        bmhdrsize = h[14] + (h[15] << 8);                                                  // dib header size (0x28 is usual)
+        // files may vary here, if unsupported type, put default values
         bmwidth = 0;
         bmheight = 0;
         bmbpp = 0;
         bmpltsize = 0;
-        if ((bmhdrsize == 0x28) || (bmhdrsize == 0x38))
+        _topDown = false;
+        if ((bmhdrsize == 0x28) || (bmhdrsize == 0x38) || (bmhdrsize == 0x6C) || (bmhdrsize == 0x7C))
         {
-            bmwidth = h[18] + (h[19] << 8);   // width
-            bmheight = h[22] + (h[23] << 8);  // height
+            int32_t height = (int32_t)(h[22] + (h[23] << 8) + ((uint32_t)h[24] << 16) + ((uint32_t)h[25] << 24));
+            bmwidth = h[18] + (h[19] << 8); // width
+            if (height < 0)
+            {
+                _topDown = true; // negative height: first row in file is the top one
+                height = -height;
+            }
+            bmheight = (height > 0x7FFF) ? 0 : height;
             bmbpp = h[28] + (h[29] << 8);     // bits per pixel
             bmpltsize = h[46] + (h[47] << 8); // palette size
         }
         // Serial.printf("bmtype: %d, bmhdrsize: %d, bmwidth: %d, bmheight: %d, bmbpp: %d\n", bmtype, bmhdrsize, bmwidth, bmheight, bmbpp);
+
+        // validate bitmap
+        if ((bmtype != 19778) || (bmwidth == 0) || (bmwidth > 0x7FFF) || (bmheight == 0))
+        {
+            return false;
+        }
+        switch (bmbpp)
+        {
+        case 1:
+        case 2:
+        case 4:
+        case 8:
+            return bmpltsize <= (1U << bmbpp);
+        case 16:
+        case 24:
+        case 32:
+            return true;
+        default:
+            return false;
+        }
     }
 
     byte isbmp(char n[])
@@ -245,15 +240,14 @@ private:
         return 1; // passes all tests
     }
 
-    BMP_DRAW_CALLBACK *_bmpDrawCallback;
     bool _useBigEndian;
-    int16_t _heightLimit;
+    bool _topDown;
 
-    uint16_t bmtype, bmdataptr;                              // from header
+    uint16_t bmtype;                                         // from header
+    uint32_t bmdataptr;                                      // from header
     uint32_t bmhdrsize, bmwidth, bmheight, bmbpp, bmpltsize; // from DIB Header
-    uint16_t bmbpl;                                          // bytes per line- derived
+    uint32_t bmbpl;                                          // bytes per line- derived
     uint16_t *bmplt;                                         // palette- stored encoded for LCD
-    uint16_t *bmpRow;
 };
 
 #endif // _BMPCLASS_H_
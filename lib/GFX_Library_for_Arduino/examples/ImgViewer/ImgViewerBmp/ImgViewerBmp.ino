@@ -96,13 +96,6 @@ Arduino_GFX *gfx = new Arduino_ILI9341(bus, DF_GFX_RST, 3 /* rotation */, false
 #include "BmpClass.h"
 static BmpClass bmpClass;
 
-// pixel drawing callback
-static void bmpDrawCallback(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h)
-{
-  // Serial.printf("Draw pos = %d, %d. size = %d x %d\n", x, y, w, h);
-  gfx->draw16bitRGBBitmap(x, y, bitmap, w, h);
-}
-
 void setup()
 {
 #ifdef DEV_DEVICE_INIT
@@ -176,10 +169,13 @@ void setup()
     File bmpFile = SD.open(BMP_FILENAME, FILE_READ);
 #endif
 
-    // read BMP file header
-    bmpClass.draw(
-        &bmpFile, bmpDrawCallback, false /* useBigEndian */,
-        0 /* x */, 0 /* y */, gfx->width() /* widthLimit */, gfx->height() /* heightLimit */);
+    // read BMP file and draw it in multi-row strips
+    if (!bmpClass.draw(
+            &bmpFile, gfx, false /* useBigEndian */,
+            0 /* x */, 0 /* y */, gfx->width() /* widthLimit */, gfx->height() /* heightLimit */))
+    {
+      Serial.println(F("ERROR: Unsupported or truncated BMP file!"));
+    }
 
     bmpFile.close();
 
@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * Pipelined Motion JPEG Image Viewer
+ * Reads, decodes and draws a Motion JPEG on an ESP32-S3 RGB panel with three
+ * tasks on two cores, see MjpegPlayer.h. Prints each stage's utilisation
+ * once a second and a summary at the end.
+ * Image Source: https://www.pexels.com/video/earth-rotating-video-856356/
+ * cropped: x: 598 y: 178 width: 720 height: 720 resized: 240x240
+ * ffmpeg -i "Pexels Videos 3931.mp4" -ss 0 -t 20.4s -vf "reverse,setpts=0.5*PTS,fps=10,vflip,hflip,rotate=90,crop=720:720:178:598,scale=240:240:flags=lanczos" -q:v 9 earth.mjpeg
+ *
+ * Dependent libraries:
+ * JPEGDEC: https://github.com/bitbank2/JPEGDEC.git
+ *
+ * Setup steps:
+ * 1. Change your LCD parameters in Arduino_GFX setting
+ * 2. Upload Motion JPEG file
+ *   FFat/LittleFS:
+ *     upload FFat (FatFS) data with ESP32 Sketch Data Upload:
+ *     ESP32: https://github.com/lorol/arduino-esp32fs-plugin
+ *   SD:
+ *     Most Arduino system built-in support SD file system.
+ ******************************************************************************/
+#define MJPEG_FILENAME "/earth.mjpeg"
+#define MJPEG_BUFFER_SIZE (240 * 240 * 2 / 10) // memory for a single JPEG frame
+#define MJPEG_TARGET_FPS 20                    // 0 to play as fast as possible
+
+/*******************************************************************************
+ * Start of Arduino_GFX setting
+ ******************************************************************************/
+#include <Arduino_GFX_Library.h>
+
+#define GFX_BL 2
+Arduino_ESP32RGBPanel *rgbpanel = new Arduino_ESP32RGBPanel(
+    40 /* DE */, 41 /* VSYNC */, 39 /* HSYNC */, 42 /* PCLK */,
+    45 /* R0 */, 48 /* R1 */, 47 /* R2 */, 21 /* R3 */, 14 /* R4 */,
+    5 /* G0 */, 6 /* G1 */, 7 /* G2 */, 15 /* G3 */, 16 /* G4 */, 4 /* G5 */,
+    8 /* B0 */, 3 /* B1 */, 46 /* B2 */, 9 /* B3 */, 1 /* B4 */,
+    0 /* hsync_polarity */, 8 /* hsync_front_porch */, 4 /* hsync_pulse_width */, 8 /* hsync_back_porch */,
+    0 /* vsync_polarity */, 8 /* vsync_front_porch */, 4 /* vsync_pulse_width */, 8 /* vsync_back_porch */,
+    1 /* pclk_active_neg */, 16000000 /* prefer_speed */, false /* useBigEndian */,
+    0 /* de_idle_high */, 0 /* pclk_idle_high */, 0 /* bounce_buffer_size_px */);
+Arduino_RGB_Display *gfx = new Arduino_RGB_Display(
+    800 /* width */, 480 /* height */, rgbpanel, 0 /* rotation */, true /* auto_flush */);
+/*******************************************************************************
+ * End of Arduino_GFX setting
+ ******************************************************************************/
+
+#include <FFat.h>
+#include <LittleFS.h>
+#include <SD.h>
+#include <SD_MMC.h>
+
+#include "MjpegPlayer.h"
+static MjpegPlayer mjpeg;
+
+static void printStats(const mjpeg_player_stats_t *s)
+{
+  float elapsed = s->elapsed_us ? s->elapsed_us : 1;
+  Serial.printf("frames read %lu, decoded %lu, dropped %lu, drawn %lu, %0.1f fps\n",
+                s->frames_read, s->frames_decoded, s->frames_dropped, s->frames_drawn,
+                1000000.0 * s->frames_drawn / elapsed);
+  Serial.printf("utilisation: read %0.1f %%, decode %0.1f %%, draw %0.1f %%\n",
+                100.0 * s->read_us / elapsed, 100.0 * s->decode_us / elapsed, 100.0 * s->draw_us / elapsed);
+}
+
+void setup()
+{
+#ifdef DEV_DEVICE_INIT
+  DEV_DEVICE_INIT();
+#endif
+
+  Serial.begin(115200);
+  // Serial.setDebugOutput(true);
+  // while(!Serial);
+  Serial.println("Arduino_GFX Pipelined Motion JPEG Image Viewer example");
+
+  // Init Display
+  if (!gfx->begin())
+  {
+    Serial.println("gfx->begin() failed!");
+  }
+  gfx->fillScreen(RGB565_BLACK);
+
+#ifdef GFX_BL
+  pinMode(GFX_BL, OUTPUT);
+  digitalWrite(GFX_BL, HIGH);
+#endif
+
+  // if (!FFat.begin())
+  if (!LittleFS.begin())
+  // SD_MMC.setPins(12 /* CLK */, 11 /* CMD/MOSI */, 13 /* D0/MISO */);
+  // if (!SD_MMC.begin("/root", true))
+  {
+    Serial.println(F("ERROR: File System Mount Failed!"));
+    gfx->println(F("ERROR: File System Mount Failed!"));
+    return;
+  }
+
+  // File mjpegFile = FFat.open(MJPEG_FILENAME, "r");
+  File mjpegFile = LittleFS.open(MJPEG_FILENAME, "r");
+  // File mjpegFile = SD_MMC.open(MJPEG_FILENAME, "r");
+  if (!mjpegFile || mjpegFile.isDirectory())
+  {
+    Serial.println(F("ERROR: Failed to open " MJPEG_FILENAME " file for reading"));
+    gfx->println(F("ERROR: Failed to open " MJPEG_FILENAME " file for reading"));
+    return;
+  }
+
+  if (!mjpeg.begin(gfx, false /* useBigEndian */, gfx->width(), gfx->height(), MJPEG_BUFFER_SIZE, MJPEG_TARGET_FPS))
+  {
+    Serial.println(F("mjpeg.begin() failed!"));
+    return;
+  }
+
+  Serial.println(F("MJPEG start"));
+  mjpeg.play(&mjpegFile);
+  mjpeg_player_stats_t stats;
+  while (mjpeg.isPlaying())
+  {
+    delay(1000);
+    mjpeg.getStats(&stats);
+    printStats(&stats);
+  }
+  Serial.println(F("MJPEG end"));
+  mjpegFile.close();
+
+  mjpeg.getStats(&stats);
+  printStats(&stats);
+  gfx->setCursor(0, 0);
+  gfx->printf("Frames drawn: %lu, dropped: %lu\n", stats.frames_drawn, stats.frames_dropped);
+  gfx->printf("Time used: %lu ms\n", stats.elapsed_us / 1000);
+}
+
+void loop()
+{
+}
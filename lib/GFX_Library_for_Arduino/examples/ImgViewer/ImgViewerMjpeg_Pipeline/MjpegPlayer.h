@@ -0,0 +1,458 @@
+/*******************************************************************************
+ * JPEGDEC pipelined MJPEG player for ESP32 dual core
+ *
+ * Three FreeRTOS tasks work on different frames at the same time:
+ *   read   - splits the stream into JPEG frames (FFD8 ... FFD9) and fills a
+ *            ring of frame buffers, blocks while the ring is full
+ *   decode - core 0, decodes a frame with JPEGDEC, each MCU row block is
+ *            copied into a small draw buffer pool and queued
+ *   draw   - core 1, sends the queued blocks to the display; on
+ *            Arduino_RGB_Display draw16bitRGBBitmap() is a copy straight into
+ *            the framebuffer, and each block is a whole MCU row of the video
+ * With a target FPS the decoder waits for each frame's due time and skips
+ * frames that are already a frame interval late, MJPEG frames are all key
+ * frames so a skipped frame costs nothing but a stutter.
+ * Every stage accumulates its busy time for utilisation statistics.
+ *
+ * Dependent libraries:
+ * JPEGDEC: https://github.com/bitbank2/JPEGDEC.git
+ ******************************************************************************/
+#pragma once
+
+#include <JPEGDEC.h>
+
+#define READ_BATCH_SIZE 1024
+
+// JPEG frames in flight between reader and decoder
+#ifndef MJPEG_PLAYER_FRAMES
+#define MJPEG_PLAYER_FRAMES 3
+#endif
+
+// MCU row blocks in flight between decoder and draw task
+#ifndef MJPEG_PLAYER_DRAW_BUFS
+#define MJPEG_PLAYER_DRAW_BUFS 4
+#endif
+
+#define MJPEG_PLAYER_DECODE_CORE 0
+#define MJPEG_PLAYER_DRAW_CORE 1
+
+#define MJPEG_END_OF_STREAM -1
+#define MJPEG_END_OF_FRAME -2
+
+typedef struct
+{
+  uint32_t frames_read;
+  uint32_t frames_decoded;
+  uint32_t frames_dropped;
+  uint32_t frames_drawn;
+  uint32_t read_us;   // busy time of each stage, waits for the other stages excluded
+  uint32_t decode_us;
+  uint32_t draw_us;
+  uint32_t elapsed_us;
+} mjpeg_player_stats_t;
+
+typedef struct
+{
+  int16_t slot; // frame buffer index or MJPEG_END_OF_STREAM
+  uint32_t len;
+  uint32_t index;
+} mjpeg_frame_t;
+
+typedef struct
+{
+  int16_t buf; // draw buffer index, MJPEG_END_OF_FRAME or MJPEG_END_OF_STREAM
+  int16_t x, y, w, h;
+} mjpeg_draw_t;
+
+class MjpegPlayer;
+static MjpegPlayer *_mjpegPlayer; // JPEGDEC draw callback has no user pointer
+
+class MjpegPlayer
+{
+public:
+  bool begin(
+      Arduino_GFX *gfx, bool useBigEndian, int widthLimit, int heightLimit,
+      size_t frameBufSize, uint8_t targetFps = 0)
+  {
+    _gfx = gfx;
+    _useBigEndian = useBigEndian;
+    _widthLimit = widthLimit;
+    _heightLimit = heightLimit;
+    _frameBufSize = frameBufSize;
+    _frame_us = targetFps ? (1000000 / targetFps) : 0;
+
+    for (uint8_t i = 0; i < MJPEG_PLAYER_FRAMES; ++i)
+    {
+      _frames[i] = (uint8_t *)(psramFound() ? ps_malloc(frameBufSize) : malloc(frameBufSize));
+      if (!_frames[i])
+      {
+        Serial.println(F("frame buffer malloc failed!"));
+        return false;
+      }
+    }
+    // a decoded block is at most 16 rows of the widest output, keep them in fast internal RAM
+    _drawBufPixels = _widthLimit * 16;
+    for (uint8_t i = 0; i < MJPEG_PLAYER_DRAW_BUFS; ++i)
+    {
+      _drawBufs[i] = (uint16_t *)heap_caps_malloc(_drawBufPixels * 2, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+      if (!_drawBufs[i])
+      {
+        _drawBufs[i] = (uint16_t *)malloc(_drawBufPixels * 2);
+      }
+      if (!_drawBufs[i])
+      {
+        Serial.println(F("draw buffer malloc failed!"));
+        return false;
+      }
+    }
+
+    _freeFrames = xQueueCreate(MJPEG_PLAYER_FRAMES, sizeof(int16_t));
+    _readyFrames = xQueueCreate(MJPEG_PLAYER_FRAMES + 1, sizeof(mjpeg_frame_t));
+    _freeDrawBufs = xQueueCreate(MJPEG_PLAYER_DRAW_BUFS, sizeof(int16_t));
+    _drawJobs = xQueueCreate(MJPEG_PLAYER_DRAW_BUFS + 2, sizeof(mjpeg_draw_t));
+    if ((!_freeFrames) || (!_readyFrames) || (!_freeDrawBufs) || (!_drawJobs))
+    {
+      Serial.println(F("queue create failed!"));
+      return false;
+    }
+
+    _mjpegPlayer = this;
+    return true;
+  }
+
+  // Start playing, returns at once, the tasks end by themselves at the end of the stream
+  bool play(Stream *input)
+  {
+    if (_playing)
+    {
+      return false;
+    }
+    _input = input;
+    _carry_len = 0;
+    _scale = -1;
+    memset(&_stats, 0, sizeof(_stats));
+    xQueueReset(_freeFrames);
+    xQueueReset(_readyFrames);
+    xQueueReset(_freeDrawBufs);
+    xQueueReset(_drawJobs);
+    for (int16_t i = 0; i < MJPEG_PLAYER_FRAMES; ++i)
+    {
+      xQueueSend(_freeFrames, &i, 0);
+    }
+    for (int16_t i = 0; i < MJPEG_PLAYER_DRAW_BUFS; ++i)
+    {
+      xQueueSend(_freeDrawBufs, &i, 0);
+    }
+
+    _playing = true;
+    _start_us = micros();
+    xTaskCreatePinnedToCore(drawTask, "mjpeg_draw", 2048, this, 2, NULL, MJPEG_PLAYER_DRAW_CORE);
+    xTaskCreatePinnedToCore(decodeTask, "mjpeg_decode", 4096, this, 2, NULL, MJPEG_PLAYER_DECODE_CORE);
+    xTaskCreatePinnedToCore(readTask, "mjpeg_read", 3072, this, 1, NULL, MJPEG_PLAYER_DRAW_CORE);
+    return true;
+  }
+
+  bool isPlaying()
+  {
+    return _playing;
+  }
+
+  void getStats(mjpeg_player_stats_t *stats)
+  {
+    *stats = _stats;
+    if (_playing)
+    {
+      stats->elapsed_us = micros() - _start_us;
+    }
+  }
+
+private:
+  static void readTask(void *arg)
+  {
+    MjpegPlayer *p = (MjpegPlayer *)arg;
+    mjpeg_frame_t f;
+    f.index = 0;
+    while (1)
+    {
+      xQueueReceive(p->_freeFrames, &f.slot, portMAX_DELAY);
+      uint32_t start = micros();
+      int32_t len = p->readFrame(p->_frames[f.slot]);
+      p->_stats.read_us += micros() - start;
+      if (len <= 0)
+      {
+        break;
+      }
+      f.len = len;
+      ++p->_stats.frames_read;
+      xQueueSend(p->_readyFrames, &f, portMAX_DELAY);
+      ++f.index;
+    }
+    f.slot = MJPEG_END_OF_STREAM;
+    xQueueSend(p->_readyFrames, &f, portMAX_DELAY);
+    vTaskDelete(NULL);
+  }
+
+  static void decodeTask(void *arg)
+  {
+    MjpegPlayer *p = (MjpegPlayer *)arg;
+    mjpeg_frame_t f;
+    mjpeg_draw_t d;
+    while (1)
+    {
+      xQueueReceive(p->_readyFrames, &f, portMAX_DELAY);
+      if (f.slot == MJPEG_END_OF_STREAM)
+      {
+        break;
+      }
+
+      if (f.index == 0)
+      {
+        p->_pts_start_us = micros();
+      }
+      if (p->_frame_us)
+      {
+        int32_t early_us = (int32_t)(p->_pts_start_us + (f.index * p->_frame_us) - micros());
+        if (early_us < -(int32_t)p->_frame_us)
+        {
+          // more than a frame late, skip it to catch up
+          ++p->_stats.frames_dropped;
+          xQueueSend(p->_freeFrames, &f.slot, portMAX_DELAY);
+          continue;
+        }
+        if (early_us >= 1000)
+        {
+          vTaskDelay(pdMS_TO_TICKS(early_us / 1000));
+        }
+      }
+
+      uint32_t start = micros();
+      p->_wait_us = 0;
+      p->decodeFrame(p->_frames[f.slot], f.len);
+      p->_stats.decode_us += micros() - start - p->_wait_us;
+      ++p->_stats.frames_decoded;
+      xQueueSend(p->_freeFrames, &f.slot, portMAX_DELAY);
+
+      d.buf = MJPEG_END_OF_FRAME;
+      xQueueSend(p->_drawJobs, &d, portMAX_DELAY);
+    }
+    d.buf = MJPEG_END_OF_STREAM;
+    xQueueSend(p->_drawJobs, &d, portMAX_DELAY);
+    vTaskDelete(NULL);
+  }
+
+  static void drawTask(void *arg)
+  {
+    MjpegPlayer *p = (MjpegPlayer *)arg;
+    mjpeg_draw_t d;
+    while (1)
+    {
+      xQueueReceive(p->_drawJobs, &d, portMAX_DELAY);
+      if (d.buf == MJPEG_END_OF_STREAM)
+      {
+        break;
+      }
+      if (d.buf == MJPEG_END_OF_FRAME)
+      {
+        ++p->_stats.frames_drawn;
+        continue;
+      }
+      uint32_t start = micros();
+      if (p->_useBigEndian)
+      {
+        p->_gfx->draw16bitBeRGBBitmap(d.x, d.y, p->_drawBufs[d.buf], d.w, d.h);
+      }
+      else
+      {
+        p->_gfx->draw16bitRGBBitmap(d.x, d.y, p->_drawBufs[d.buf], d.w, d.h);
+      }
+      p->_stats.draw_us += micros() - start;
+      xQueueSend(p->_freeDrawBufs, &d.buf, portMAX_DELAY);
+    }
+    p->_stats.elapsed_us = micros() - p->_start_us;
+    p->_playing = false;
+    vTaskDelete(NULL);
+  }
+
+  // Copy the next JPEG frame into buf, return its length, 0 at the end of the stream
+  int32_t readFrame(uint8_t *buf)
+  {
+    // bytes read past the previous FFD9
+    memcpy(buf, _carry, _carry_len);
+    int32_t len = _carry_len;
+    _carry_len = 0;
+    int32_t scan = 0;
+    bool in_frame = false;
+
+    while (1)
+    {
+      if (!in_frame)
+      {
+        int32_t i = scan;
+        while ((i < (len - 1)) && (!((buf[i] == 0xFF) && (buf[i + 1] == 0xD8))))
+        {
+          ++i;
+        }
+        if (i < (len - 1))
+        {
+          // move the JPEG header to the start of buf
+          if (i > 0)
+          {
+            memmove(buf, buf + i, len - i);
+            len -= i;
+          }
+          in_frame = true;
+          scan = 2;
+        }
+        else
+        {
+          // keep a trailing 0xFF, it may be the first half of FFD8
+          if ((len > 0) && (buf[len - 1] == 0xFF))
+          {
+            buf[0] = 0xFF;
+            len = 1;
+          }
+          else
+          {
+            len = 0;
+          }
+          scan = 0;
+        }
+      }
+      if (in_frame)
+      {
+        int32_t i = scan;
+        while ((i < (len - 1)) && (!((buf[i] == 0xFF) && (buf[i + 1] == 0xD9))))
+        {
+          ++i;
+        }
+        if (i < (len - 1))
+        {
+          int32_t frame_len = i + 2;
+          _carry_len = len - frame_len;
+          memcpy(_carry, buf + frame_len, _carry_len);
+          return frame_len;
+        }
+        scan = (len > 2) ? (len - 1) : 2;
+      }
+
+      if ((len + READ_BATCH_SIZE) > (int32_t)_frameBufSize)
+      {
+        // frame larger than the buffer, drop what we have and look for the next header
+        Serial.println(F("MJPEG frame too large, skipped"));
+        in_frame = false;
+        len = 0;
+        scan = 0;
+      }
+      int32_t r = _input->readBytes(buf + len, READ_BATCH_SIZE);
+      if (r <= 0)
+      {
+        return 0;
+      }
+      len += r;
+    }
+  }
+
+  void decodeFrame(uint8_t *buf, uint32_t len)
+  {
+    _jpeg.openRAM(buf, len, jpegDrawCallback);
+    if (_scale == -1)
+    {
+      // scale to fit height, one callback per full width MCU row
+      int iMaxMCUs;
+      int w = _jpeg.getWidth();
+      int h = _jpeg.getHeight();
+      float ratio = (float)h / _heightLimit;
+      if (ratio <= 1)
+      {
+        _scale = 0;
+        iMaxMCUs = _widthLimit / 16;
+      }
+      else if (ratio <= 2)
+      {
+        _scale = JPEG_SCALE_HALF;
+        iMaxMCUs = _widthLimit / 8;
+        w /= 2;
+        h /= 2;
+      }
+      else if (ratio <= 4)
+      {
+        _scale = JPEG_SCALE_QUARTER;
+        iMaxMCUs = _widthLimit / 4;
+        w /= 4;
+        h /= 4;
+      }
+      else
+      {
+        _scale = JPEG_SCALE_EIGHTH;
+        iMaxMCUs = _widthLimit / 2;
+        w /= 8;
+        h /= 8;
+      }
+      _maxMCUs = iMaxMCUs;
+      _x = (w > _widthLimit) ? 0 : ((_widthLimit - w) / 2);
+      _y = (_heightLimit - h) / 2;
+    }
+    _jpeg.setMaxOutputSize(_maxMCUs);
+    if (_useBigEndian)
+    {
+      _jpeg.setPixelType(RGB565_BIG_ENDIAN);
+    }
+    _jpeg.decode(_x, _y, _scale);
+    _jpeg.close();
+  }
+
+  // JPEGDEC reuses its output buffer for the next block, hand a copy to the draw task
+  static int jpegDrawCallback(JPEGDRAW *pDraw)
+  {
+    MjpegPlayer *p = _mjpegPlayer;
+    int32_t pixels = pDraw->iWidth * pDraw->iHeight;
+    if (pixels > p->_drawBufPixels)
+    {
+      return 0;
+    }
+
+    uint32_t start = micros();
+    mjpeg_draw_t d;
+    xQueueReceive(p->_freeDrawBufs, &d.buf, portMAX_DELAY);
+    p->_wait_us += micros() - start;
+
+    memcpy(p->_drawBufs[d.buf], pDraw->pPixels, pixels * 2);
+    d.x = pDraw->x;
+    d.y = pDraw->y;
+    d.w = pDraw->iWidth;
+    d.h = pDraw->iHeight;
+    xQueueSend(p->_drawJobs, &d, portMAX_DELAY);
+    return 1;
+  }
+
+  Arduino_GFX *_gfx;
+  Stream *_input;
+  bool _useBigEndian;
+  int _x;
+  int _y;
+  int _widthLimit;
+  int _heightLimit;
+  int _scale = -1;
+  int _maxMCUs;
+
+  JPEGDEC _jpeg;
+
+  size_t _frameBufSize;
+  uint8_t *_frames[MJPEG_PLAYER_FRAMES];
+  uint8_t _carry[READ_BATCH_SIZE];
+  int32_t _carry_len = 0;
+  uint16_t *_drawBufs[MJPEG_PLAYER_DRAW_BUFS];
+  int32_t _drawBufPixels;
+
+  QueueHandle_t _freeFrames;
+  QueueHandle_t _readyFrames;
+  QueueHandle_t _freeDrawBufs;
+  QueueHandle_t _drawJobs;
+
+  uint32_t _frame_us;
+  uint32_t _start_us;
+  uint32_t _pts_start_us; // due time of the first frame
+  uint32_t _wait_us;
+  volatile bool _playing = false;
+  mjpeg_player_stats_t _stats;
+};
@@ -156,16 +156,59 @@ int32_t mySeek(PNGFILE *handle, int32_t position)
   return pngFile.seek(position);
 }
 
+// Opaque images are collected into multi-row strips, images with alpha are
+// drawn line by line through the transparency mask
+Arduino_ImageStrip *pngStrip;
+uint16_t *usPixels;
+uint8_t *usMask;
+
 // Function to draw pixels to the display
 void PNGDraw(PNGDRAW *pDraw)
 {
-  uint16_t usPixels[320];
-  uint8_t usMask[320];
-
   // Serial.printf("Draw pos = 0,%d. size = %d x 1\n", pDraw->y, pDraw->iWidth);
-  png.getLineAsRGB565(pDraw, usPixels, PNG_RGB565_LITTLE_ENDIAN, 0x00000000);
-  png.getAlphaMask(pDraw, usMask, 1);
-  gfx->draw16bitRGBBitmapWithMask(xOffset, yOffset + pDraw->y, usPixels, usMask, pDraw->iWidth, 1);
+  if (pngStrip)
+  {
+    png.getLineAsRGB565(pDraw, pngStrip->nextRow(), PNG_RGB565_LITTLE_ENDIAN, 0x00000000);
+  }
+  else
+  {
+    png.getLineAsRGB565(pDraw, usPixels, PNG_RGB565_LITTLE_ENDIAN, 0x00000000);
+    png.getAlphaMask(pDraw, usMask, 1);
+    gfx->draw16bitRGBBitmapWithMask(xOffset, yOffset + pDraw->y, usPixels, usMask, pDraw->iWidth, 1);
+  }
+}
+
+// Decode the opened PNG at (xOffset, yOffset), line buffers sized from the image width
+int decodePNG()
+{
+  int16_t pw = png.getWidth();
+  int rc = PNG_MEM_ERROR;
+
+  if (!png.hasAlpha())
+  {
+    pngStrip = new Arduino_ImageStrip(gfx, pw);
+    if (pngStrip->begin())
+    {
+      pngStrip->start(xOffset, yOffset);
+      rc = png.decode(NULL, 0);
+      pngStrip->flush();
+    }
+    delete pngStrip;
+    pngStrip = nullptr;
+  }
+  else
+  {
+    usPixels = (uint16_t *)malloc(pw * 2);
+    usMask = (uint8_t *)malloc((pw + 7) / 8);
+    if (usPixels && usMask)
+    {
+      rc = png.decode(NULL, 0);
+    }
+    free(usPixels);
+    free(usMask);
+  }
+
+  return rc;
 }
 
 void setup()
@@ -239,7 +282,7 @@ void setup()
       xOffset = (w - pw) / 2;
       yOffset = (h - ph) / 2;
 
-      rc = png.decode(NULL, 0);
+      rc = decodePNG();
 
       Serial.printf("Draw offset: (%d, %d), time used: %lu\n", xOffset, yOffset, millis() - start);
       Serial.printf("image specs: (%d x %d), %d bpp, pixel type: %d\n", png.getWidth(), png.getHeight(), png.getBpp(), png.getPixelType());
@@ -267,7 +310,7 @@ void loop()
     xOffset = random(w) - (pw / 2);
     yOffset = random(h) - (ph / 2);
 
-    rc = png.decode(NULL, 0);
+    rc = decodePNG();
 
     Serial.printf("Draw offset: (%d, %d), time used: %lu\n", xOffset, yOffset, millis() - start);
     Serial.printf("image specs: (%d x %d), %d bpp, pixel type: %d\n", png.getWidth(), png.getHeight(), png.getBpp(), png.getPixelType());
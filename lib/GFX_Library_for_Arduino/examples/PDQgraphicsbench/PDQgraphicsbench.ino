@@ -0,0 +1,331 @@
+/*******************************************************************************
+ * PDQgraphicstest as a regression benchmark
+ * Runs every PDQgraphicstest primitive test against two targets that need no
+ * display hardware:
+ *   canvas  - a memory backed Arduino_Canvas, measures drawing code alone
+ *   ili9341 - an Arduino_ILI9341 driver on Arduino_TraceBus, measures the
+ *             driver and counts the bus traffic it would generate
+ * Results are printed to Serial as CSV, one line per target and test:
+ *   target,test,usec,transactions,addr_windows,data_bytes
+ * usec is the fastest of BENCH_ROUNDS runs, the bus columns are per run and
+ * stay 0 for the canvas. Only host compilable classes are used, so the same
+ * sketch runs on a board or on the desktop: 'make pdq_bench' in test/host
+ * builds it against stub Arduino headers and writes build/pdq_bench.csv.
+ * Compare two runs to catch primitive level regressions.
+ ******************************************************************************/
+#include <Arduino_GFX_Library.h>
+
+#define BENCH_W 240
+#define BENCH_H 320
+#define BENCH_ROUNDS 3
+
+Arduino_TraceBus *bus = new Arduino_TraceBus();
+Arduino_GFX *tft = new Arduino_ILI9341(bus, GFX_NOT_DEFINED /* RST */, 0 /* rotation */, false /* IPS */);
+Arduino_Canvas *canvas = new Arduino_Canvas(BENCH_W, BENCH_H, nullptr);
+
+Arduino_GFX *gfx;
+int32_t w, h, n, n1, cx, cy, cx1, cy1, cn, cn1;
+uint8_t tsa, tsc;
+
+typedef void (*bench_test_t)();
+
+void testFillScreen()
+{
+  gfx->fillScreen(RGB565_WHITE);
+  gfx->fillScreen(RGB565_RED);
+  gfx->fillScreen(RGB565_LIME);
+  gfx->fillScreen(RGB565_BLUE);
+  gfx->fillScreen(RGB565_BLACK);
+}
+
+void testText()
+{
+  gfx->setCursor(0, 0);
+
+  gfx->setTextSize(1);
+  gfx->setTextColor(RGB565_WHITE, RGB565_BLACK);
+  gfx->println("Hello World!");
+
+  gfx->setTextSize(2);
+  gfx->setTextColor(gfx->color565(0xff, 0x00, 0x00));
+  gfx->print("RED ");
+  gfx->setTextColor(gfx->color565(0x00, 0xff, 0x00));
+  gfx->print("GREEN ");
+  gfx->setTextColor(gfx->color565(0x00, 0x00, 0xff));
+  gfx->println("BLUE");
+
+  gfx->setTextSize(tsa);
+  gfx->setTextColor(RGB565_YELLOW);
+  gfx->println(1234.56);
+
+  gfx->setTextColor(RGB565_WHITE);
+  gfx->println(0xDEADBEEF, HEX);
+
+  gfx->setTextColor(RGB565_CYAN, RGB565_WHITE);
+  gfx->println("Groop,");
+
+  gfx->setTextSize(tsc);
+  gfx->setTextColor(RGB565_MAGENTA, RGB565_WHITE);
+  gfx->println("I implore thee,");
+
+  gfx->setTextSize(1);
+  gfx->setTextColor(RGB565_NAVY, RGB565_WHITE);
+  gfx->println("my foonting turlingdromes.");
+  gfx->setTextColor(RGB565_DARKGREEN, RGB565_WHITE);
+  gfx->println("And hooptiously drangle me");
+  gfx->setTextColor(RGB565_DARKCYAN, RGB565_WHITE);
+  gfx->println("with crinkly bindlewurdles,");
+
+  for (uint8_t s = 2; s <= 9; ++s)
+  {
+    gfx->setTextSize(s);
+    gfx->setTextColor(gfx->color565(s * 28, 0xff - (s * 28), 0x80));
+    gfx->print("Size ");
+    gfx->println(s);
+  }
+}
+
+void testPixels()
+{
+  for (int16_t y = 0; y < h; y++)
+  {
+    for (int16_t x = 0; x < w; x++)
+    {
+      gfx->drawPixel(x, y, gfx->color565(x << 3, y << 3, x * y));
+    }
+  }
+}
+
+void testLines()
+{
+  // the eight fans of PDQgraphicstest, from each corner to the two far edges
+  const int32_t corners[4][2] = {{0, 0}, {w - 1, 0}, {0, h - 1}, {w - 1, h - 1}};
+  for (uint8_t c = 0; c < 4; ++c)
+  {
+    int32_t x1 = corners[c][0];
+    int32_t y1 = corners[c][1];
+    int32_t x_far = (w - 1) - x1;
+    int32_t y_far = (h - 1) - y1;
+    for (int32_t x2 = 0; x2 < w; x2 += 6)
+    {
+      gfx->drawLine(x1, y1, x2, y_far, RGB565_BLUE);
+    }
+    for (int32_t y2 = 0; y2 < h; y2 += 6)
+    {
+      gfx->drawLine(x1, y1, x_far, y2, RGB565_BLUE);
+    }
+  }
+}
+
+void testFastLines()
+{
+  for (int32_t y = 0; y < h; y += 5)
+  {
+    gfx->drawFastHLine(0, y, w, RGB565_RED);
+  }
+  for (int32_t x = 0; x < w; x += 5)
+  {
+    gfx->drawFastVLine(x, 0, h, RGB565_BLUE);
+  }
+}
+
+void testFilledRects()
+{
+  for (int32_t i = n; i > 0; i -= 6)
+  {
+    int32_t i2 = i / 2;
+    gfx->fillRect(cx - i2, cy - i2, i, i, gfx->color565(i, i, 0));
+  }
+}
+
+void testRects()
+{
+  for (int32_t i = 2; i < n; i += 6)
+  {
+    int32_t i2 = i / 2;
+    gfx->drawRect(cx - i2, cy - i2, i, i, RGB565_LIME);
+  }
+}
+
+void testFilledCircles()
+{
+  for (int32_t x = 10; x < w; x += 20)
+  {
+    for (int32_t y = 10; y < h; y += 20)
+    {
+      gfx->fillCircle(x, y, 10, RGB565_MAGENTA);
+    }
+  }
+}
+
+void testCircles()
+{
+  for (int32_t x = 0; x < w + 10; x += 20)
+  {
+    for (int32_t y = 0; y < h + 10; y += 20)
+    {
+      gfx->drawCircle(x, y, 10, RGB565_WHITE);
+    }
+  }
+}
+
+void testFillArcs()
+{
+  int16_t r = (360 > cn) ? (360 / cn) : 1;
+  for (int16_t i = 6; i < cn; i += 6)
+  {
+    gfx->fillArc(cx1, cy1, i, i - 3, 0, i * r, RGB565_RED);
+  }
+}
+
+void testArcs()
+{
+  int16_t r = (360 > cn) ? (360 / cn) : 1;
+  for (int16_t i = 6; i < cn; i += 6)
+  {
+    gfx->drawArc(cx1, cy1, i, i - 3, 0, i * r, RGB565_WHITE);
+  }
+}
+
+void testFilledTriangles()
+{
+  for (int32_t i = cn1; i > 10; i -= 5)
+  {
+    gfx->fillTriangle(cx1, cy1 - i, cx1 - i, cy1 + i, cx1 + i, cy1 + i,
+                      gfx->color565(0, i, i));
+  }
+}
+
+void testTriangles()
+{
+  for (int32_t i = 0; i < cn; i += 5)
+  {
+    gfx->drawTriangle(cx1, cy1 - i, cx1 - i, cy1 + i, cx1 + i, cy1 + i,
+                      gfx->color565(0, 0, i));
+  }
+}
+
+void testFilledRoundRects()
+{
+  for (int32_t i = n1; i > 20; i -= 6)
+  {
+    int32_t i2 = i / 2;
+    gfx->fillRoundRect(cx - i2, cy - i2, i, i, i / 8, gfx->color565(0, i, 0));
+  }
+}
+
+void testRoundRects()
+{
+  for (int32_t i = 20; i < n1; i += 6)
+  {
+    int32_t i2 = i / 2;
+    gfx->drawRoundRect(cx - i2, cy - i2, i, i, i / 8, gfx->color565(i, 0, 0));
+  }
+}
+
+const struct
+{
+  const char *name;
+  bench_test_t test;
+} tests[] = {
+    {"fill_screen", testFillScreen},
+    {"text", testText},
+    {"pixels", testPixels},
+    {"lines", testLines},
+    {"hv_lines", testFastLines},
+    {"rects_filled", testFilledRects},
+    {"rects", testRects},
+    {"triangles_filled", testFilledTriangles},
+    {"triangles", testTriangles},
+    {"circles_filled", testFilledCircles},
+    {"circles", testCircles},
+    {"arcs_filled", testFillArcs},
+    {"arcs", testArcs},
+    {"round_rects_filled", testFilledRoundRects},
+    {"round_rects", testRoundRects},
+};
+
+void runTarget(const char *target, Arduino_GFX *target_gfx, Arduino_TraceBus *target_bus)
+{
+  gfx = target_gfx;
+  for (size_t t = 0; t < sizeof(tests) / sizeof(tests[0]); ++t)
+  {
+    uint32_t best = 0xFFFFFFFF;
+    for (uint8_t r = 0; r < BENCH_ROUNDS; ++r)
+    {
+      gfx->fillScreen(RGB565_BLACK);
+      if (target_bus)
+      {
+        target_bus->resetStats();
+      }
+      uint32_t start = micros();
+      tests[t].test();
+      uint32_t us = micros() - start;
+      if (us < best)
+      {
+        best = us;
+      }
+    }
+
+    Serial.print(target);
+    Serial.print(',');
+    Serial.print(tests[t].name);
+    Serial.print(',');
+    Serial.print(best);
+    if (target_bus)
+    {
+      const gfx_bus_stats_t *s = target_bus->getStats();
+      Serial.print(',');
+      Serial.print(s->transactions);
+      Serial.print(',');
+      Serial.print(s->addr_windows);
+      Serial.print(',');
+      Serial.println(s->data_bytes);
+    }
+    else
+    {
+      Serial.println(",0,0,0");
+    }
+  }
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  // Serial.setDebugOutput(true);
+  // while(!Serial);
+
+  if (!canvas->begin(GFX_SKIP_OUTPUT_BEGIN))
+  {
+    Serial.println("canvas->begin() failed!");
+    return;
+  }
+  if (!tft->begin())
+  {
+    Serial.println("tft->begin() failed!");
+    return;
+  }
+
+  w = BENCH_W;
+  h = BENCH_H;
+  n = min(w, h);
+  n1 = n - 1;
+  cx = w / 2;
+  cy = h / 2;
+  cx1 = cx - 1;
+  cy1 = cy - 1;
+  cn = min(cx1, cy1);
+  cn1 = cn - 1;
+  tsa = 2; // text sizes PDQgraphicstest picks for 240x320
+  tsc = 1;
+
+  Serial.println("target,test,usec,transactions,addr_windows,data_bytes");
+  runTarget("canvas", canvas, nullptr);
+  runTarget("ili9341", tft, bus);
+  Serial.println("# done");
+}
+
+void loop()
+{
+  delay(1000);
+}
@@ -0,0 +1,170 @@
+/*******************************************************************************
+ * Sprite Compositor Demo
+ * A background layer and a few soft edged balls with 8-bit alpha stacked by
+ * Arduino_Compositor. Each frame only the rectangles the balls left and
+ * entered are composed and sent to the display, the background is never
+ * redrawn as a whole.
+ * The compositor and the background canvas each take a full screen RGB565
+ * buffer (150 KB at 320x240), so both need a board with PSRAM. Without it the
+ * background canvas is dropped and the balls move over a plain color.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Start of Arduino_GFX setting
+ *
+ * Arduino_GFX try to find the settings depends on selected board in Arduino IDE
+ * Or you can define the display dev kit not in the board list
+ * More default pin lists: see HelloWorld example
+ ******************************************************************************/
+#include <Arduino_GFX_Library.h>
+
+#define GFX_BL DF_GFX_BL // default backlight pin, you may replace DF_GFX_BL to actual backlight pin
+
+/* More dev device declaration: https://github.com/moononournation/Arduino_GFX/wiki/Dev-Device-Declaration */
+#if defined(DISPLAY_DEV_KIT)
+Arduino_GFX *gfx = create_default_Arduino_GFX();
+#else /* !defined(DISPLAY_DEV_KIT) */
+
+/* More data bus class: https://github.com/moononournation/Arduino_GFX/wiki/Data-Bus-Class */
+Arduino_DataBus *bus = create_default_Arduino_DataBus();
+
+/* More display class: https://github.com/moononournation/Arduino_GFX/wiki/Display-Class */
+Arduino_GFX *gfx = new Arduino_ILI9341(bus, DF_GFX_RST, 3 /* rotation */, false /* IPS */);
+
+#endif /* !defined(DISPLAY_DEV_KIT) */
+/*******************************************************************************
+ * End of Arduino_GFX setting
+ ******************************************************************************/
+
+#define BALL_COUNT 3
+#define BALL_SIZE 40
+
+Arduino_Compositor *compositor;
+Arduino_Canvas *background;
+uint16_t ball_pixels[BALL_COUNT][BALL_SIZE * BALL_SIZE];
+uint8_t ball_alpha[BALL_SIZE * BALL_SIZE];
+int8_t ball_layer[BALL_COUNT];
+int16_t ball_x[BALL_COUNT], ball_y[BALL_COUNT], ball_dx[BALL_COUNT], ball_dy[BALL_COUNT];
+int16_t w, h;
+
+bool ready = false;
+unsigned long frames = 0;
+unsigned long nextSnap = 0;
+
+void setup()
+{
+#ifdef DEV_DEVICE_INIT
+  DEV_DEVICE_INIT();
+#endif
+
+  Serial.begin(115200);
+  // Serial.setDebugOutput(true);
+  // while(!Serial);
+  Serial.println("Arduino_GFX Sprite Compositor example");
+
+  if (!gfx->begin())
+  {
+    Serial.println("gfx->begin() failed!");
+  }
+  w = gfx->width();
+  h = gfx->height();
+
+#ifdef GFX_BL
+  pinMode(GFX_BL, OUTPUT);
+  digitalWrite(GFX_BL, HIGH);
+#endif
+
+  compositor = new Arduino_Compositor(w, h, gfx);
+  if (!compositor->begin(GFX_SKIP_OUTPUT_BEGIN))
+  {
+    Serial.println("Compositor allocation failed, needs PSRAM?");
+    return;
+  }
+
+  // the background is an ordinary canvas, draw into it with any GFX call
+  background = new Arduino_Canvas(w, h, nullptr);
+  if (background->begin(GFX_SKIP_OUTPUT_BEGIN))
+  {
+    for (int16_t y = 0; y < h; ++y)
+    {
+      background->drawFastHLine(0, y, w, background->color565(0, y * 128 / h, 64 + (y * 191 / h)));
+    }
+    background->setTextColor(RGB565_WHITE);
+    background->setTextSize(2);
+    background->setCursor(8, h - 24);
+    background->print("Arduino_Compositor");
+    compositor->addLayer(background);
+  }
+  else
+  {
+    Serial.println("Background canvas allocation failed, using a plain background");
+    delete background;
+    background = nullptr;
+    compositor->setBackground(RGB565_NAVY);
+  }
+
+  // one shared alpha mask: opaque center fading to half at the edge
+  int16_t r = BALL_SIZE / 2;
+  for (int16_t y = 0; y < BALL_SIZE; ++y)
+  {
+    for (int16_t x = 0; x < BALL_SIZE; ++x)
+    {
+      int32_t d2 = (x - r) * (x - r) + (y - r) * (y - r);
+      ball_alpha[y * BALL_SIZE + x] = (d2 >= r * r) ? 0 : 255 - (d2 * 127 / (r * r));
+    }
+  }
+
+  const uint16_t colors[BALL_COUNT] = {RGB565_RED, RGB565_YELLOW, RGB565_CYAN};
+  for (uint8_t i = 0; i < BALL_COUNT; ++i)
+  {
+    for (int16_t p = 0; p < BALL_SIZE * BALL_SIZE; ++p)
+    {
+      ball_pixels[i][p] = colors[i];
+    }
+    ball_x[i] = random(w - BALL_SIZE);
+    ball_y[i] = random(h - BALL_SIZE);
+    ball_dx[i] = random(2) ? (1 + i) : -(1 + i);
+    ball_dy[i] = random(2) ? (3 - i) : -(3 - i);
+    ball_layer[i] = compositor->addLayer(ball_pixels[i], ball_alpha, BALL_SIZE, BALL_SIZE, ball_x[i], ball_y[i]);
+  }
+  compositor->setLayerOpacity(ball_layer[1], 160); // half see-through
+
+  compositor->flush();
+  ready = true;
+}
+
+void loop()
+{
+  if (!ready)
+  {
+    delay(1000);
+    return;
+  }
+
+  for (uint8_t i = 0; i < BALL_COUNT; ++i)
+  {
+    ball_x[i] += ball_dx[i];
+    ball_y[i] += ball_dy[i];
+    if ((ball_x[i] < 0) || (ball_x[i] > (w - BALL_SIZE)))
+    {
+      ball_dx[i] = -ball_dx[i];
+      ball_x[i] += ball_dx[i];
+    }
+    if ((ball_y[i] < 0) || (ball_y[i] > (h - BALL_SIZE)))
+    {
+      ball_dy[i] = -ball_dy[i];
+      ball_y[i] += ball_dy[i];
+    }
+    compositor->moveLayer(ball_layer[i], ball_x[i], ball_y[i]);
+  }
+
+  compositor->flush();
+
+  ++frames;
+  if (millis() > nextSnap)
+  {
+    Serial.printf("fps: %lu\n", frames);
+    frames = 0;
+    nextSnap = millis() + 1000;
+  }
+}
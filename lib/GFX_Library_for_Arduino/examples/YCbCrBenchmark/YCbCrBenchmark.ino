@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * YCbCr to RGB565 conversion benchmark
+ * Times the per pixel table lookup conversion against the block converter
+ * gfx_ycbcr_to_rgb565() on a full 800x480 frame, for 4:2:0 and 4:2:2 chroma,
+ * and checks both give the same pixels.
+ * No display is needed, results are printed to Serial.
+ * The frame buffers use PSRAM when available, otherwise a 320x240 frame is used.
+ ******************************************************************************/
+#include <Arduino_GFX_Library.h>
+
+#define BENCH_ROUNDS 10
+
+static int16_t frame_w = 800;
+static int16_t frame_h = 480;
+static uint8_t *y_plane;
+static uint8_t *cb_plane;
+static uint8_t *cr_plane;
+static uint16_t *out_table;
+static uint16_t *out_block;
+
+static void *frame_malloc(size_t size)
+{
+#if defined(ESP32)
+  if (psramFound())
+  {
+    return ps_malloc(size);
+  }
+#endif
+  return malloc(size);
+}
+
+// the conversion the display and bus classes used before, kept here for reference
+static void table_convert(int16_t w, int16_t h, bool chroma_420, uint16_t *out)
+{
+  uint8_t *yData = y_plane;
+  uint8_t *cbData = cb_plane;
+  uint8_t *crData = cr_plane;
+  int16_t cols = w >> 1;
+  uint8_t pxCb, pxCr;
+  int16_t pxR, pxG, pxB, pxY;
+
+  for (int16_t row = 0; row < h; ++row)
+  {
+    for (int16_t col = 0; col < cols; ++col)
+    {
+      pxCb = *cbData++;
+      pxCr = *crData++;
+      pxR = CR2R16[pxCr];
+      pxG = -CB2G16[pxCb] - CR2G16[pxCr];
+      pxB = CB2B16[pxCb];
+      pxY = Y2I16[*yData++];
+      *out++ = CLIPR[pxY + pxR] | CLIPG[pxY + pxG] | CLIPB[pxY + pxB];
+      pxY = Y2I16[*yData++];
+      *out++ = CLIPR[pxY + pxR] | CLIPG[pxY + pxG] | CLIPB[pxY + pxB];
+    }
+    if (chroma_420 && !(row & 1))
+    {
+      // second row of the pair reuses the chroma row
+      cbData -= cols;
+      crData -= cols;
+    }
+  }
+}
+
+static void bench(bool chroma_420)
+{
+  uint32_t start = micros();
+  for (int i = 0; i < BENCH_ROUNDS; ++i)
+  {
+    table_convert(frame_w, frame_h, chroma_420, out_table);
+  }
+  uint32_t us_table = (micros() - start) / BENCH_ROUNDS;
+
+  start = micros();
+  for (int i = 0; i < BENCH_ROUNDS; ++i)
+  {
+    gfx_ycbcr_to_rgb565(y_plane, cb_plane, cr_plane, frame_w, frame_h, chroma_420, out_block, frame_w, false);
+  }
+  uint32_t us_block = (micros() - start) / BENCH_ROUNDS;
+
+  bool same = (memcmp(out_table, out_block, (size_t)frame_w * frame_h * 2) == 0);
+
+  Serial.printf("%s %dx%d: per pixel %lu us (%.1f fps), block %lu us (%.1f fps), output %s\n",
+                chroma_420 ? "4:2:0" : "4:2:2", frame_w, frame_h,
+                (unsigned long)us_table, 1000000.0 / us_table,
+                (unsigned long)us_block, 1000000.0 / us_block,
+                same ? "identical" : "DIFFERENT");
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  // Serial.setDebugOutput(true);
+  // while(!Serial);
+  Serial.println("Arduino_GFX YCbCr to RGB565 benchmark");
+
+#if defined(ESP32)
+  if (!psramFound())
+#endif
+  {
+    frame_w = 320;
+    frame_h = 240;
+  }
+
+  size_t pixels = (size_t)frame_w * frame_h;
+  y_plane = (uint8_t *)frame_malloc(pixels);
+  cb_plane = (uint8_t *)frame_malloc(pixels / 2); // enough for 4:2:2
+  cr_plane = (uint8_t *)frame_malloc(pixels / 2);
+  out_table = (uint16_t *)frame_malloc(pixels * 2);
+  out_block = (uint16_t *)frame_malloc(pixels * 2);
+  if (!y_plane || !cb_plane || !cr_plane || !out_table || !out_block)
+  {
+    Serial.println("Frame buffers allocation failed!");
+    return;
+  }
+
+  // smooth gradients with some noise, closer to video than pure noise
+  for (size_t i = 0; i < pixels; ++i)
+  {
+    y_plane[i] = ((i % frame_w) * 255 / frame_w + random(16)) & 0xFF;
+  }
+  for (size_t i = 0; i < pixels / 2; ++i)
+  {
+    cb_plane[i] = 64 + ((i * 128) / (pixels / 2));
+    cr_plane[i] = 192 - ((i % (frame_w / 2)) * 128 / (frame_w / 2));
+  }
+
+  bench(true);
+  bench(false);
+}
+
+void loop()
+{
+  delay(1000);
+}
@@ -181,36 +181,84 @@ void Arduino_DataBus::writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uin
 
 void Arduino_DataBus::writeYCbCrPixels(uint8_t *yData, uint8_t *cbData, uint8_t *crData, uint16_t w, uint16_t h)
 {
+  // convert a short run of each row at a time and hand it to writePixels()
+  uint16_t buf[64];
   int cols = w >> 1;
 
-  uint8_t pxCb, pxCr;
-  int16_t pxR, pxG, pxB, pxY;
-
-  for (int row = 0; row < h;)
+  for (int row = 0; row < h; ++row)
   {
-    for (int col = 0; col < cols; ++col)
+    for (int col = 0; col < w; col += 64)
     {
-      pxCb = *cbData++;
-      pxCr = *crData++;
-      pxR = CR2R16[pxCr];
-      pxG = -CB2G16[pxCb] - CR2G16[pxCr];
-      pxB = CB2B16[pxCb];
-
-      pxY = Y2I16[*yData++];
-      _data16.value = CLIPRBE[pxY + pxR] | CLIPGBE[pxY + pxG] | CLIPBBE[pxY + pxB];
-      write(_data16.lsb);
-      write(_data16.msb);
-      pxY = Y2I16[*yData++];
-      _data16.value = CLIPRBE[pxY + pxR] | CLIPGBE[pxY + pxG] | CLIPBBE[pxY + pxB];
-      write(_data16.lsb);
-      write(_data16.msb);
+      int16_t l = ((w - col) < 64) ? (w - col) : 64;
+      gfx_ycbcr_to_rgb565(yData + col, cbData + (col >> 1), crData + (col >> 1), l, 1, false, buf, l, false);
+      writePixels(buf, l);
+    }
+    yData += w;
+    if (row & 1)
+    {
+      // next chroma row every second luma row
+      cbData += cols;
+      crData += cols;
     }
+  }
+}
+
+// Returns once data may be reused, the last transfers may still be running until waitIdle()
+// or the next bus call. Buses without queued transfers just write the pixels.
+void Arduino_DataBus::writePixelsAsync(uint16_t *data, uint32_t len)
+{
+  writePixels(data, len);
+}
+
+void Arduino_DataBus::waitIdle()
+{
+}
+
+// r, g, b: chroma terms of one sample, shared by its 2 or 4 pixels
+GFX_INLINE static void gfx_ycbcr_chroma(uint8_t cb, uint8_t cr, int32_t *r, int32_t *g, int32_t *b)
+{
+  *r = CR2R16[cr];
+  *g = -CB2G16[cb] - CR2G16[cr];
+  *b = CB2B16[cb];
+}
+
+GFX_INLINE static uint16_t gfx_ycbcr_pixel(uint8_t y8, int32_t r, int32_t g, int32_t b, bool big_endian)
+{
+  int32_t y = Y2I16[y8];
+  if (big_endian)
+  {
+    return CLIPRBE[y + r] | CLIPGBE[y + g] | CLIPBBE[y + b];
+  }
+  return CLIPR[y + r] | CLIPG[y + g] | CLIPB[y + b];
+}
+
+void gfx_ycbcr_to_rgb565(const uint8_t *yData, const uint8_t *cbData, const uint8_t *crData, int16_t w, int16_t h,
+                         bool chroma_420, uint16_t *out, int32_t out_stride, bool big_endian)
+{
+  int16_t cols = w >> 1;
+  int16_t lines = chroma_420 ? 2 : 1; // luma rows per chroma row
 
-    if (++row & 1)
+  for (int16_t row = 0; row < h; row += lines)
+  {
+    bool pair = chroma_420 && ((row + 1) < h);
+    const uint8_t *y1 = yData + (row * w);
+    const uint8_t *y2 = y1 + w;
+    uint16_t *d1 = out + (row * out_stride);
+    uint16_t *d2 = d1 + out_stride;
+
+    for (int16_t col = 0; col < cols; ++col)
     {
-      // rollback CbCr data
-      cbData -= cols;
-      crData -= cols;
+      // chroma contribution shared by the 2 (4:2:2) or 4 (4:2:0) pixels of this sample
+      int32_t r, g, b;
+      gfx_ycbcr_chroma(*cbData++, *crData++, &r, &g, &b);
+
+      *d1++ = gfx_ycbcr_pixel(*y1++, r, g, b, big_endian);
+      *d1++ = gfx_ycbcr_pixel(*y1++, r, g, b, big_endian);
+      if (pair)
+      {
+        *d2++ = gfx_ycbcr_pixel(*y2++, r, g, b, big_endian);
+        *d2++ = gfx_ycbcr_pixel(*y2++, r, g, b, big_endian);
+      }
     }
   }
 }
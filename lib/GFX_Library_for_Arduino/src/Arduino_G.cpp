@@ -133,21 +133,31 @@ bool gfx_draw_bitmap_to_framebuffer_rotate_1(
       x = 0;
     }
 
-    uint16_t *p;
-    int16_t i;
-    for (int16_t j = 0; j < bitmap_h; j++)
+    // transpose in blocks, each framebuffer row of a block is written in one cache line
+    // while the block's bitmap rows stay in cache for the strided reads
+    int16_t pitch = bitmap_w + x_skip;
+    uint16_t *origin = framebuffer + (x * framebuffer_h) + (framebuffer_h - y - 1); // bitmap pixel (0, 0)
+    for (int16_t jb = 0; jb < bitmap_h; jb += GFX_ROTATE_BLOCK_SIZE)
     {
-      p = framebuffer;
-      p += (x * framebuffer_h);     // shift framebuffer to y offset
-      p += (framebuffer_h - y - j - 1); // shift framebuffer to x offset
-
-      i = bitmap_w;
-      while (i--)
+      int16_t bh = ((bitmap_h - jb) < GFX_ROTATE_BLOCK_SIZE) ? (bitmap_h - jb) : GFX_ROTATE_BLOCK_SIZE;
+      for (int16_t ib = 0; ib < bitmap_w; ib += GFX_ROTATE_BLOCK_SIZE)
       {
-        *p = *from_bitmap++;
-        p += framebuffer_h;
+        int16_t bw = ((bitmap_w - ib) < GFX_ROTATE_BLOCK_SIZE) ? (bitmap_w - ib) : GFX_ROTATE_BLOCK_SIZE;
+        uint16_t *src = from_bitmap + (jb * pitch) + ib;
+        uint16_t *dst = origin + (ib * framebuffer_h) - jb;
+        for (int16_t i = 0; i < bw; ++i)
+        {
+          uint16_t *s = src + i;
+          uint16_t *p = dst;
+          int16_t j = bh;
+          while (j--)
+          {
+            *p-- = *s;
+            s += pitch;
+          }
+          dst += framebuffer_h;
+        }
       }
-      from_bitmap += x_skip;
     }
     return true;
   }
@@ -254,21 +264,30 @@ bool gfx_draw_bitmap_to_framebuffer_rotate_3(
       x = 0;
     }
 
-    uint16_t *p;
-    int16_t i;
-    for (int16_t j = 0; j < bitmap_h; j++)
+    // same blocking as rotate_1, with framebuffer rows running the other way
+    int16_t pitch = bitmap_w + x_skip;
+    uint16_t *origin = framebuffer + ((max_X - x) * framebuffer_h) + y; // bitmap pixel (0, 0)
+    for (int16_t jb = 0; jb < bitmap_h; jb += GFX_ROTATE_BLOCK_SIZE)
     {
-      p = framebuffer;
-      p += ((max_X - x) * framebuffer_h); // shift framebuffer to y offset
-      p += y + j;                         // shift framebuffer to x offset
-
-      i = bitmap_w;
-      while (i--)
+      int16_t bh = ((bitmap_h - jb) < GFX_ROTATE_BLOCK_SIZE) ? (bitmap_h - jb) : GFX_ROTATE_BLOCK_SIZE;
+      for (int16_t ib = 0; ib < bitmap_w; ib += GFX_ROTATE_BLOCK_SIZE)
       {
-        *p = *from_bitmap++;
-        p -= framebuffer_h;
+        int16_t bw = ((bitmap_w - ib) < GFX_ROTATE_BLOCK_SIZE) ? (bitmap_w - ib) : GFX_ROTATE_BLOCK_SIZE;
+        uint16_t *src = from_bitmap + (jb * pitch) + ib;
+        uint16_t *dst = origin - (ib * framebuffer_h) + jb;
+        for (int16_t i = 0; i < bw; ++i)
+        {
+          uint16_t *s = src + i;
+          uint16_t *p = dst;
+          int16_t j = bh;
+          while (j--)
+          {
+            *p++ = *s;
+            s += pitch;
+          }
+          dst -= framebuffer_h;
+        }
       }
-      from_bitmap += x_skip;
     }
     return true;
   }
@@ -26,6 +26,11 @@ protected:
 
 #endif // _ARDUINO_G_H_
 
+// Square block size, in pixels, of the transposing rotate_1 / rotate_3 framebuffer copies
+#ifndef GFX_ROTATE_BLOCK_SIZE
+#define GFX_ROTATE_BLOCK_SIZE 16
+#endif
+
 // utility functions
 bool gfx_draw_bitmap_to_framebuffer(
     uint16_t *from_bitmap, int16_t bitmap_w, int16_t bitmap_h,
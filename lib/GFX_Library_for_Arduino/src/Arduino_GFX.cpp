@@ -51,6 +51,10 @@ Arduino_GFX::Arduino_GFX(int16_t w, int16_t h) : Arduino_G(w, h)
   u8g2Font = NULL;
 #endif // defined(U8G2_FONT_SUPPORT)
 #endif // !defined(ATTINY_CORE)
+#if (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
+  invalidateTextBoundsCache();
+  resetTextBoundsCacheStats();
+#endif // (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
 }
 
 /**************************************************************************/
@@ -216,6 +220,23 @@ void Arduino_GFX::writeFastHLine(int16_t x, int16_t y,
   }
 }
 
+/**************************************************************************/
+/*!
+  @brief  Write a batch of horizontal lines sharing one color, overwrite in subclasses that can reach the framebuffer directly
+  @param  spans   (x, y, w) triples, one per line
+  @param  count   Number of lines in spans
+  @param  color   16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void Arduino_GFX::writeHLineSpans(const int16_t *spans, uint16_t count, uint16_t color)
+{
+  while (count--)
+  {
+    writeFastHLine(spans[0], spans[1], spans[2], color);
+    spans += 3;
+  }
+}
+
 /**************************************************************************/
 /*!
   @brief  Draw a filled rectangle to the display. Not self-contained;
@@ -733,6 +754,72 @@ void Arduino_GFX::fillArc(int16_t x, int16_t y, int16_t r1, int16_t r2, float st
   endWrite();
 }
 
+#if GFX_FAST_ARC
+/**************************************************************************/
+/*!
+  @brief  Integer square root
+  @param  n   Value to take the root of, negative counts as 0
+  @return floor(sqrt(n))
+*/
+/**************************************************************************/
+static int32_t gfx_isqrt(int32_t n)
+{
+  if (n <= 0)
+  {
+    return 0;
+  }
+  uint32_t op = n;
+  uint32_t res = 0;
+  uint32_t one = 1UL << 30;
+  while (one > op)
+  {
+    one >>= 2;
+  }
+  while (one)
+  {
+    if (op >= res + one)
+    {
+      op -= res + one;
+      res = (res >> 1) + one;
+    }
+    else
+    {
+      res >>= 1;
+    }
+    one >>= 2;
+  }
+  return res;
+}
+
+/**************************************************************************/
+/*!
+  @brief  Largest integer x with x <= v, clamped to the int16_t range
+  @param  v   Edge position, may be infinite or NaN
+*/
+/**************************************************************************/
+static int32_t gfx_floor_threshold(float v)
+{
+  if (!(v >= (float)INT16_MIN)) // also NaN, no x can be <= NaN
+  {
+    return INT16_MIN - 1;
+  }
+  if (v >= (float)INT16_MAX)
+  {
+    return INT16_MAX;
+  }
+  return (int32_t)floorf(v);
+}
+
+GFX_INLINE static void gfx_span_push(int32_t *spans, uint8_t &cnt, int32_t s, int32_t e)
+{
+  if (s <= e)
+  {
+    spans[cnt++] = s;
+    spans[cnt++] = e;
+  }
+}
+#endif // GFX_FAST_ARC
+
 /**************************************************************************/
 /*!
   @brief  Arc drawer with fill
@@ -794,6 +881,109 @@ void Arduino_GFX::writeFillArcHelper(int16_t cx, int16_t cy, int16_t oradius, in
       y = 0;
     }
   }
+#if GFX_FAST_ARC
+  do
+  {
+    int32_t y2 = y * y;
+    // outer circle: x * x + y2 < or2
+    int32_t xo = gfx_isqrt(or2 - y2 - 1);
+    int32_t x = xs;
+    if (x < 0)
+    {
+      x = -xo;
+      if (xe != 1)
+      {
+        xe = 1 - x;
+      }
+    }
+    float ysslope = (y + swidth) * sslope;
+    float yeslope = (y + ewidth) * eslope;
+
+    // annulus part of the row: [x, min(xo, xe - 1)] minus the inner hole
+    int32_t ring[4];
+    uint8_t ring_cnt = 0;
+    int32_t rx1 = (xo < xe - 1) ? xo : (xe - 1);
+    int32_t hole = (ir2 > y2) ? (gfx_isqrt(ir2 - y2 - 1) + 1) : 0; // inner circle: |x| < hole
+    if (hole > 0)
+    {
+      gfx_span_push(ring, ring_cnt, x, (rx1 < -hole) ? rx1 : -hole);
+      gfx_span_push(ring, ring_cnt, (x > hole) ? x : hole, rx1);
+    }
+    else
+    {
+      gfx_span_push(ring, ring_cnt, x, rx1);
+    }
+
+    // angle part of the row, each edge splits the row at an integer threshold
+    int32_t t1 = gfx_floor_threshold(ysslope);
+    int32_t t2 = gfx_floor_threshold(yeslope);
+    int32_t f1s = start180 ? (t1 + 1) : INT16_MIN, f1e = start180 ? INT16_MAX : t1;
+    int32_t f2s = end180 ? (t2 + 1) : INT16_MIN, f2e = end180 ? INT16_MAX : t2;
+    int32_t sector[4];
+    uint8_t sector_cnt = 0;
+    if (reversed)
+    {
+      // union of both half lines
+      if (f1s > f2s)
+      {
+        int32_t t = f1s;
+        f1s = f2s;
+        f2s = t;
+        t = f1e;
+        f1e = f2e;
+        f2e = t;
+      }
+      if ((f1e + 1) >= f2s)
+      {
+        gfx_span_push(sector, sector_cnt, f1s, (f1e > f2e) ? f1e : f2e);
+      }
+      else
+      {
+        gfx_span_push(sector, sector_cnt, f1s, f1e);
+        gfx_span_push(sector, sector_cnt, f2s, f2e);
+      }
+    }
+    else
+    {
+      // intersection of both half lines
+      gfx_span_push(sector, sector_cnt, (f1s > f2s) ? f1s : f2s, (f1e < f2e) ? f1e : f2e);
+    }
+
+    // emit the intersection, joining touching spans into one line
+    int32_t run_s = 0, run_e = -1;
+    bool run = false;
+    for (uint8_t i = 0; i < ring_cnt; i += 2)
+    {
+      for (uint8_t j = 0; j < sector_cnt; j += 2)
+      {
+        int32_t s = (ring[i] > sector[j]) ? ring[i] : sector[j];
+        int32_t e = (ring[i + 1] < sector[j + 1]) ? ring[i + 1] : sector[j + 1];
+        if (s > e)
+        {
+          continue;
+        }
+        if (run && (s == run_e + 1))
+        {
+          run_e = e;
+        }
+        else
+        {
+          if (run)
+          {
+            writeFastHLine(cx + run_s, cy + y, run_e - run_s + 1, color);
+          }
+          run_s = s;
+          run_e = e;
+          run = true;
+        }
+      }
+    }
+    if (run)
+    {
+      writeFastHLine(cx + run_s, cy + y, run_e - run_s + 1, color);
+    }
+  } while (++y <= ye);
+#else  // !GFX_FAST_ARC
   do
   {
     int32_t y2 = y * y;
@@ -837,6 +1027,7 @@ void Arduino_GFX::writeFillArcHelper(int16_t cx, int16_t cy, int16_t oradius, in
       }
     } while (++x <= xe);
   } while (++y <= ye);
+#endif // !GFX_FAST_ARC
 }
 
 /**************************************************************************/
@@ -939,6 +1130,24 @@ void Arduino_GFX::drawTriangle(int16_t x0, int16_t y0,
   endWrite();
 }
 
+/**************************************************************************/
+/*!
+  @brief  Append a horizontal line to a span batch, flushing the batch when it is full
+*/
+/**************************************************************************/
+GFX_INLINE static void gfx_span_add(Arduino_GFX *gfx, int16_t *spans, uint16_t &cnt, int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+  int16_t *p = spans + (cnt * 3);
+  p[0] = x;
+  p[1] = y;
+  p[2] = w;
+  if (++cnt == GFX_SPAN_BATCH_SIZE)
+  {
+    gfx->writeHLineSpans(spans, cnt, color);
+    cnt = 0;
+  }
+}
+
 /**************************************************************************/
 /*!
   @brief  Draw a triangle with color-fill
@@ -990,6 +1199,8 @@ void Arduino_GFX::fillTriangle(int16_t x0, int16_t y0,
     return;
   }
 
+  int16_t spans[GFX_SPAN_BATCH_SIZE * 3];
+  uint16_t span_cnt = 0;
   int16_t
       dx01 = x1 - x0,
       dy01 = y1 - y0,
@@ -1030,7 +1241,7 @@ void Arduino_GFX::fillTriangle(int16_t x0, int16_t y0,
     {
       _swap_int16_t(a, b);
     }
-    writeFastHLine(a, y, b - a + 1, color);
+    gfx_span_add(this, spans, span_cnt, a, y, b - a + 1, color);
   }
 
   // For lower part of triangle, find scanline crossings for segments
@@ -1051,11 +1262,272 @@ void Arduino_GFX::fillTriangle(int16_t x0, int16_t y0,
     {
       _swap_int16_t(a, b);
     }
-    writeFastHLine(a, y, b - a + 1, color);
+    gfx_span_add(this, spans, span_cnt, a, y, b - a + 1, color);
+  }
+  if (span_cnt)
+  {
+    writeHLineSpans(spans, span_cnt, color);
+  }
+  endWrite();
+}
+
+#if !defined(LITTLE_FOOT_PRINT)
+// Polygons with up to this many vertices keep their edge table on the stack
+#define GFX_POLYGON_STACK_EDGES 16
+
+/**************************************************************************/
+/*!
+  @brief  Add the spans of a polygon to a span batch, using the even-odd rule.
+    Vertices are pixel centres. Pixels on the left and top edges are filled and those
+    on the right and bottom edges are not, so polygons sharing an edge neither overlap nor leave gaps.
+  @param  points    Array of x, y vertex coordinate pairs
+  @param  indices   Order the vertices are visited in, NULL to take the points in order
+  @param  n         Number of vertices
+  @param  spans     Span batch, GFX_SPAN_BATCH_SIZE (x, y, w) triples
+  @param  span_cnt  Number of spans already in the batch
+  @param  color     16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void Arduino_GFX::writeFillPolygonHelper(const int16_t *points, const uint16_t *indices, uint16_t n,
+                                         int16_t *spans, uint16_t &span_cnt, uint16_t color)
+{
+  if (n < 3)
+  {
+    return;
+  }
+
+  gfx_poly_edge_t stack_edges[GFX_POLYGON_STACK_EDGES];
+  int32_t stack_xs[GFX_POLYGON_STACK_EDGES];
+  uint16_t stack_active[GFX_POLYGON_STACK_EDGES];
+  gfx_poly_edge_t *edges = stack_edges;
+  int32_t *xs_buf = stack_xs;
+  uint16_t *active = stack_active;
+  if (n > GFX_POLYGON_STACK_EDGES)
+  {
+    edges = (gfx_poly_edge_t *)malloc(n * (sizeof(gfx_poly_edge_t) + sizeof(int32_t) + sizeof(uint16_t)));
+    if (!edges)
+    {
+      return;
+    }
+    xs_buf = (int32_t *)(edges + n);
+    active = (uint16_t *)(xs_buf + n);
+  }
+
+  // Build the edge table sorted by first scanline, dropping edges that cannot cross a visible scanline
+  uint16_t edge_cnt = 0;
+  int16_t ymin = INT16_MAX;
+  int16_t ymax = INT16_MIN; // exclusive
+  for (uint16_t i = 0; i < n; ++i)
+  {
+    uint16_t ia = indices ? indices[i] : i;
+    uint16_t ib = indices ? indices[(i + 1) % n] : ((i + 1) % n);
+    int16_t xa = points[ia * 2], ya = points[ia * 2 + 1];
+    int16_t xb = points[ib * 2], yb = points[ib * 2 + 1];
+    if (ya == yb)
+    {
+      continue;
+    }
+    if (ya > yb)
+    {
+      _swap_int16_t(xa, xb);
+      _swap_int16_t(ya, yb);
+    }
+    if ((yb <= 0) || (ya >= _height))
+    {
+      continue;
+    }
+
+    // crossings are stepped exactly as a whole part plus a remainder over dy, so shared
+    // edges and crossings landing on pixel centres come out the same from every polygon
+    gfx_poly_edge_t e;
+    int32_t dx = xb - xa;
+    e.dy = yb - ya;
+    e.y0 = (ya < 0) ? 0 : ya;
+    e.y1 = (yb > _height) ? _height : yb;
+    int64_t num = (int64_t)dx * (e.y0 - ya);
+    int32_t q = (int32_t)(num / e.dy);
+    int32_t r = (int32_t)(num - ((int64_t)q * e.dy));
+    if (r < 0)
+    {
+      --q;
+      r += e.dy;
+    }
+    e.x = xa + q;
+    e.rem = r;
+    e.dx = dx / e.dy;
+    e.dx_rem = dx - (e.dx * e.dy);
+    if (e.dx_rem < 0)
+    {
+      --e.dx;
+      e.dx_rem += e.dy;
+    }
+
+    uint16_t k = edge_cnt++;
+    while ((k > 0) && (edges[k - 1].y0 > e.y0))
+    {
+      edges[k] = edges[k - 1];
+      --k;
+    }
+    edges[k] = e;
+    if (e.y0 < ymin)
+    {
+      ymin = e.y0;
+    }
+    if (e.y1 > ymax)
+    {
+      ymax = e.y1;
+    }
+  }
+
+  uint16_t next = 0;
+  uint16_t active_cnt = 0;
+  for (int16_t y = ymin; y < ymax; ++y)
+  {
+    // step the edges still crossing this scanline, retire the rest
+    uint16_t k = 0;
+    for (uint16_t i = 0; i < active_cnt; ++i)
+    {
+      gfx_poly_edge_t *e = &edges[active[i]];
+      if (e->y1 > y)
+      {
+        e->x += e->dx;
+        e->rem += e->dx_rem;
+        if (e->rem >= e->dy)
+        {
+          e->rem -= e->dy;
+          ++e->x;
+        }
+        active[k++] = active[i];
+      }
+    }
+    active_cnt = k;
+    while ((next < edge_cnt) && (edges[next].y0 == y))
+    {
+      active[active_cnt++] = next++;
+    }
+
+    // only the first pixel centre right of each crossing matters, sort on that;
+    // crossings stay nearly sorted from one scanline to the next
+    for (uint16_t i = 0; i < active_cnt; ++i)
+    {
+      uint16_t t = active[i];
+      int32_t tx = edges[t].x + (edges[t].rem ? 1 : 0);
+      uint16_t j = i;
+      while ((j > 0) && (xs_buf[j - 1] > tx))
+      {
+        active[j] = active[j - 1];
+        xs_buf[j] = xs_buf[j - 1];
+        --j;
+      }
+      active[j] = t;
+      xs_buf[j] = tx;
+    }
+
+    for (uint16_t i = 1; i < active_cnt; i += 2)
+    {
+      int32_t xs = xs_buf[i - 1];
+      int32_t xe = xs_buf[i] - 1;
+      if (xs < 0)
+      {
+        xs = 0;
+      }
+      if (xe > _max_x)
+      {
+        xe = _max_x;
+      }
+      if (xs <= xe)
+      {
+        gfx_span_add(this, spans, span_cnt, xs, y, xe - xs + 1, color);
+      }
+    }
+  }
+
+  if (edges != stack_edges)
+  {
+    free(edges);
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief  Draw a polygon with color-fill, convex, concave or self-intersecting (even-odd rule)
+  @param  points  Array of n x, y vertex coordinate pairs
+  @param  n       Number of vertices
+  @param  color   16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void Arduino_GFX::fillPolygon(const int16_t *points, uint16_t n, uint16_t color)
+{
+  int16_t spans[GFX_SPAN_BATCH_SIZE * 3];
+  uint16_t span_cnt = 0;
+
+  startWrite();
+  writeFillPolygonHelper(points, NULL, n, spans, span_cnt, color);
+  if (span_cnt)
+  {
+    writeHLineSpans(spans, span_cnt, color);
+  }
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+  @brief  Draw an indexed triangle mesh with a single color, shared edges are drawn once
+  @param  points      Array of x, y vertex coordinate pairs
+  @param  indices     Three vertex indices per triangle
+  @param  triangles   Number of triangles
+  @param  color       16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void Arduino_GFX::fillTriangleMesh(const int16_t *points, const uint16_t *indices, uint16_t triangles, uint16_t color)
+{
+  int16_t spans[GFX_SPAN_BATCH_SIZE * 3];
+  uint16_t span_cnt = 0;
+
+  startWrite();
+  for (uint16_t t = 0; t < triangles; ++t)
+  {
+    writeFillPolygonHelper(points, indices + (t * 3), 3, spans, span_cnt, color);
+  }
+  if (span_cnt)
+  {
+    writeHLineSpans(spans, span_cnt, color);
   }
   endWrite();
 }
 
+/**************************************************************************/
+/*!
+  @brief  Draw an indexed triangle mesh with a color per triangle, shared edges are drawn once
+  @param  points      Array of x, y vertex coordinate pairs
+  @param  indices     Three vertex indices per triangle
+  @param  triangles   Number of triangles
+  @param  colors      16-bit 5-6-5 Color of each triangle
+*/
+/**************************************************************************/
+void Arduino_GFX::fillTriangleMesh(const int16_t *points, const uint16_t *indices, uint16_t triangles, const uint16_t *colors)
+{
+  int16_t spans[GFX_SPAN_BATCH_SIZE * 3];
+  uint16_t span_cnt = 0;
+
+  startWrite();
+  for (uint16_t t = 0; t < triangles; ++t)
+  {
+    if (span_cnt && (colors[t] != colors[t - 1]))
+    {
+      writeHLineSpans(spans, span_cnt, colors[t - 1]);
+      span_cnt = 0;
+    }
+    writeFillPolygonHelper(points, indices + (t * 3), 3, spans, span_cnt, colors[t]);
+  }
+  if (span_cnt)
+  {
+    writeHLineSpans(spans, span_cnt, colors[triangles - 1]);
+  }
+  endWrite();
+}
+#endif // !defined(LITTLE_FOOT_PRINT)
+
 // BITMAP / XBITMAP / GRAYSCALE / RGB BITMAP FUNCTIONS ---------------------
 
 /**************************************************************************/
@@ -1636,6 +2108,142 @@ void Arduino_GFX::draw16bitBeRGBBitmapR1(int16_t x, int16_t y,
   }
   endWrite();
 }
+
+/**************************************************************************/
+/*!
+  @brief  Copy a screen area to another position, for displays that can read
+    back their own pixels. The generic version has nothing to read from.
+  @param  src_x   Top left corner x coordinate of the source area
+  @param  src_y   Top left corner y coordinate of the source area
+  @param  dst_x   Top left corner x coordinate of the destination
+  @param  dst_y   Top left corner y coordinate of the destination
+  @param  w       Width of area in pixels
+  @param  h       Height of area in pixels
+  @return true if copied, false if the caller has to redraw the area itself
+*/
+/**************************************************************************/
+bool Arduino_GFX::copyRect(int16_t src_x, int16_t src_y, int16_t dst_x, int16_t dst_y, int16_t w, int16_t h)
+{
+  UNUSED(src_x);
+  UNUSED(src_y);
+  UNUSED(dst_x);
+  UNUSED(dst_y);
+  UNUSED(w);
+  UNUSED(h);
+  return false;
+}
+
+/**************************************************************************/
+/*!
+  @brief  Clip a copyRect() to the screen and map it to the unrotated
+    framebuffer, for the subclasses that copy within their own framebuffer
+  @param  src_x   Source x, updated
+  @param  src_y   Source y, updated
+  @param  dst_x   Destination x, updated
+  @param  dst_y   Destination y, updated
+  @param  w       Width, updated
+  @param  h       Height, updated
+  @return false if nothing is left to copy
+*/
+/**************************************************************************/
+bool Arduino_GFX::copyRectMap(int16_t &src_x, int16_t &src_y, int16_t &dst_x, int16_t &dst_y, int16_t &w, int16_t &h)
+{
+  // clip both areas to the screen, moving them together
+  if (src_x < 0)
+  {
+    dst_x -= src_x;
+    w += src_x;
+    src_x = 0;
+  }
+  if (dst_x < 0)
+  {
+    src_x -= dst_x;
+    w += dst_x;
+    dst_x = 0;
+  }
+  if (src_y < 0)
+  {
+    dst_y -= src_y;
+    h += src_y;
+    src_y = 0;
+  }
+  if (dst_y < 0)
+  {
+    src_y -= dst_y;
+    h += dst_y;
+    dst_y = 0;
+  }
+  int16_t max_x = (src_x > dst_x) ? src_x : dst_x;
+  int16_t max_y = (src_y > dst_y) ? src_y : dst_y;
+  if ((max_x + w) > _width)
+  {
+    w = _width - max_x;
+  }
+  if ((max_y + h) > _height)
+  {
+    h = _height - max_y;
+  }
+  if ((w <= 0) || (h <= 0))
+  {
+    return false;
+  }
+
+  if (_rotation > 0)
+  {
+    int16_t t;
+    switch (_rotation)
+    {
+    case 1:
+      t = src_x;
+      src_x = WIDTH - src_y - h;
+      src_y = t;
+      t = dst_x;
+      dst_x = WIDTH - dst_y - h;
+      dst_y = t;
+      t = w;
+      w = h;
+      h = t;
+      break;
+    case 2:
+      src_x = WIDTH - src_x - w;
+      src_y = HEIGHT - src_y - h;
+      dst_x = WIDTH - dst_x - w;
+      dst_y = HEIGHT - dst_y - h;
+      break;
+    case 3:
+      t = src_x;
+      src_x = src_y;
+      src_y = HEIGHT - t - w;
+      t = dst_x;
+      dst_x = dst_y;
+      dst_y = HEIGHT - t - w;
+      t = w;
+      w = h;
+      h = t;
+      break;
+    }
+  }
+  return true;
+}
+
+void gfx_copy_rect16(uint16_t *fb, int32_t stride, int16_t src_x, int16_t src_y, int16_t dst_x, int16_t dst_y, int16_t w, int16_t h)
+{
+  // rows move in the direction that never overwrites a row before it is read
+  uint16_t *src = fb + ((int32_t)src_y * stride) + src_x;
+  uint16_t *dst = fb + ((int32_t)dst_y * stride) + dst_x;
+  if (dst_y > src_y)
+  {
+    src += (h - 1) * stride;
+    dst += (h - 1) * stride;
+    stride = -stride;
+  }
+  for (int16_t j = 0; j < h; j++)
+  {
+    memmove(dst, src, w * 2);
+    src += stride;
+    dst += stride;
+  }
+}
 #endif // !defined(LITTLE_FOOT_PRINT)
 
 /**************************************************************************/
@@ -2532,6 +3140,9 @@ void Arduino_GFX::setTextSize(uint8_t s_x, uint8_t s_y, uint8_t pixel_margin)
   text_pixel_margin = ((pixel_margin < s_x) && (pixel_margin < s_y)) ? pixel_margin : 0;
   textsize_x = (s_x > 0) ? s_x : 1;
   textsize_y = (s_y > 0) ? s_y : 1;
+#if (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
+  invalidateTextBoundsCache();
+#endif // (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
 }
 
 /**************************************************************************/
@@ -2581,6 +3192,9 @@ void Arduino_GFX::setFont(const GFXfont *f)
 #if defined(U8G2_FONT_SUPPORT)
   u8g2Font = NULL;
 #endif // defined(U8G2_FONT_SUPPORT)
+#if (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
+  invalidateTextBoundsCache();
+#endif // (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
 }
 
 /**************************************************************************/
@@ -2598,6 +3212,9 @@ void Arduino_GFX::setFont(const uint8_t *font)
 {
   gfxFont = NULL;
   u8g2Font = (uint8_t *)font;
+#if (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
+  invalidateTextBoundsCache();
+#endif // (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
 
   // extract from u8g2_read_font_info()
   /* offset 0 */
@@ -2647,6 +3264,9 @@ void Arduino_GFX::setFont(const uint8_t *font)
 void Arduino_GFX::setUTF8Print(bool isEnable)
 {
   _enableUTF8Print = isEnable;
+#if (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
+  invalidateTextBoundsCache();
+#endif // (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
 }
 #endif // defined(U8G2_FONT_SUPPORT)
 
@@ -2939,6 +3559,21 @@ void Arduino_GFX::getTextBounds(const char *str, int16_t x, int16_t y,
 {
   uint8_t c; // Current character
 
+#if (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
+  uint32_t hash = 2166136261UL; // FNV-1a
+  size_t len = 0;
+  for (const char *p = str; (c = *p); ++p, ++len)
+  {
+    hash = (hash ^ c) * 16777619UL;
+  }
+  const char *start_str = str;
+  int16_t start_x = x, start_y = y;
+  if (textBoundsCacheGet(str, false, hash, len, x, y, x1, y1, w, h))
+  {
+    return;
+  }
+#endif // (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
+
   *x1 = x;
   *y1 = y;
   *w = *h = 0;
@@ -2960,6 +3595,10 @@ void Arduino_GFX::getTextBounds(const char *str, int16_t x, int16_t y,
     *y1 = miny;
     *h = maxy - miny + 1;
   }
+
+#if (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
+  textBoundsCachePut(start_str, false, hash, len, start_x, start_y, *x1, *y1, *w, *h);
+#endif // (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
 }
 
 /**************************************************************************/
@@ -3000,6 +3639,20 @@ void Arduino_GFX::getTextBounds(const __FlashStringHelper *str,
 {
   uint8_t *s = (uint8_t *)str, c;
 
+#if (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
+  uint32_t hash = 2166136261UL; // FNV-1a
+  size_t len = 0;
+  for (uint8_t *p = s; (c = pgm_read_byte(p)); ++p, ++len)
+  {
+    hash = (hash ^ c) * 16777619UL;
+  }
+  int16_t start_x = x, start_y = y;
+  if (textBoundsCacheGet((const char *)str, true, hash, len, x, y, x1, y1, w, h))
+  {
+    return;
+  }
+#endif // (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
+
   *x1 = x;
   *y1 = y;
   *w = *h = 0;
@@ -3019,7 +3672,120 @@ void Arduino_GFX::getTextBounds(const __FlashStringHelper *str,
     *y1 = miny;
     *h = maxy - miny + 1;
   }
+
+#if (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
+  textBoundsCachePut((const char *)str, true, hash, len, start_x, start_y, *x1, *y1, *w, *h);
+#endif // (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
+}
+
+#if (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
+/**************************************************************************/
+/*!
+  @brief  Forget all remembered getTextBounds() results. Called whenever
+    font, text size, wrap or text bound changes.
+*/
+/**************************************************************************/
+void Arduino_GFX::invalidateTextBoundsCache()
+{
+  for (uint8_t i = 0; i < GFX_TEXT_BOUNDS_CACHE_SIZE; ++i)
+  {
+    _tbc[i].len = 0;
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief  Reset getTextBounds() cache hit and miss counters
+*/
+/**************************************************************************/
+void Arduino_GFX::resetTextBoundsCacheStats()
+{
+  _tbc_hits = 0;
+  _tbc_misses = 0;
+}
+
+/**************************************************************************/
+/*!
+  @brief  Look up a previous getTextBounds() result, direct mapped by hash.
+    A hit needs the same string, not just the same hash: strings longer than
+    GFX_TEXT_BOUNDS_CACHE_MAX_LEN are never cached.
+  @param  str     The string
+  @param  progmem str is in flash, read it with pgm_read_byte()
+  @param  hash    FNV-1a hash of the string
+  @param  len     String length
+  @param  x       The current cursor X
+  @param  y       The current cursor Y
+  @return true and bounds filled if found
+*/
+/**************************************************************************/
+bool Arduino_GFX::textBoundsCacheGet(const char *str, bool progmem, uint32_t hash, size_t len, int16_t x, int16_t y,
+                                     int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h)
+{
+#if defined(U8G2_FONT_SUPPORT)
+  if (_utf8_state != 0) // bounds depend on a pending multi-byte sequence
+  {
+    return false;
+  }
+#endif // defined(U8G2_FONT_SUPPORT)
+  if ((len == 0) || (len > GFX_TEXT_BOUNDS_CACHE_MAX_LEN))
+  {
+    return false;
+  }
+
+  gfx_text_bounds_t *e = &_tbc[hash % GFX_TEXT_BOUNDS_CACHE_SIZE];
+  bool same = (e->len == len) && (e->hash == hash) && (e->x == x) && (e->y == y);
+  for (size_t i = 0; same && (i < len); ++i)
+  {
+    same = (e->str[i] == (char)(progmem ? pgm_read_byte(str + i) : str[i]));
+  }
+  if (same)
+  {
+    *x1 = e->x1;
+    *y1 = e->y1;
+    *w = e->w;
+    *h = e->h;
+    ++_tbc_hits;
+    return true;
+  }
+
+  ++_tbc_misses;
+  return false;
+}
+
+/**************************************************************************/
+/*!
+  @brief  Remember a getTextBounds() result, replacing the slot's previous one
+*/
+/**************************************************************************/
+void Arduino_GFX::textBoundsCachePut(const char *str, bool progmem, uint32_t hash, size_t len, int16_t x, int16_t y,
+                                     int16_t x1, int16_t y1, uint16_t w, uint16_t h)
+{
+#if defined(U8G2_FONT_SUPPORT)
+  if (_utf8_state != 0) // string ended inside a multi-byte sequence
+  {
+    return;
+  }
+#endif // defined(U8G2_FONT_SUPPORT)
+  if ((len == 0) || (len > GFX_TEXT_BOUNDS_CACHE_MAX_LEN))
+  {
+    return;
+  }
+
+  gfx_text_bounds_t *e = &_tbc[hash % GFX_TEXT_BOUNDS_CACHE_SIZE];
+  e->hash = hash;
+  e->len = len;
+  for (size_t i = 0; i < len; ++i)
+  {
+    e->str[i] = progmem ? pgm_read_byte(str + i) : str[i];
+  }
+  e->x = x;
+  e->y = y;
+  e->x1 = x1;
+  e->y1 = y1;
+  e->w = w;
+  e->h = h;
 }
+#endif // (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
 
 /**************************************************************************/
 /*!
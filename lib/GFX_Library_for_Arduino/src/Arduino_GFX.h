@@ -29,6 +29,34 @@
 #include "font/u8g2_font_unifont_h_utf8.h"
 #endif
 
+// Number of getTextBounds() results remembered, 0 to disable
+#ifndef GFX_TEXT_BOUNDS_CACHE_SIZE
+#if defined(LITTLE_FOOT_PRINT)
+#define GFX_TEXT_BOUNDS_CACHE_SIZE 0
+#else
+#define GFX_TEXT_BOUNDS_CACHE_SIZE 8
+#endif
+#endif
+
+// Longest string getTextBounds() remembers; each slot keeps a copy to compare on a hit
+#ifndef GFX_TEXT_BOUNDS_CACHE_MAX_LEN
+#define GFX_TEXT_BOUNDS_CACHE_MAX_LEN 32
+#endif
+
+// Fill arcs by computing each row's spans directly instead of testing every pixel, 0 for the per pixel version
+#ifndef GFX_FAST_ARC
+#define GFX_FAST_ARC 1
+#endif
+
+// Number of horizontal spans collected by the triangle and polygon fills before handing them to writeHLineSpans()
+#ifndef GFX_SPAN_BATCH_SIZE
+#if defined(LITTLE_FOOT_PRINT)
+#define GFX_SPAN_BATCH_SIZE 1
+#else
+#define GFX_SPAN_BATCH_SIZE 32
+#endif
+#endif
+
 #define RGB565(r, g, b) ((((r) & 0xF8) << 8) | (((g) & 0xFC) << 3) | ((b) >> 3))
 #define RGB16TO24(c) ((((uint32_t)c & 0xF800) << 8) | ((c & 0x07E0) << 5) | ((c & 0x1F) << 3))
 
@@ -268,6 +296,11 @@ GFX_INLINE static uint8_t *pgm_read_bitmap_ptr(const GFXfont *gfxFont)
 }
 #endif // !defined(ATTINY_CORE)
 
+#if !defined(LITTLE_FOOT_PRINT)
+// Move a w x h block of an RGB565 framebuffer with stride pixels per row, the two areas may overlap
+void gfx_copy_rect16(uint16_t *fb, int32_t stride, int16_t src_x, int16_t src_y, int16_t dst_x, int16_t dst_y, int16_t w, int16_t h);
+#endif // !defined(LITTLE_FOOT_PRINT)
+
 /// A generic graphics superclass that can handle all sorts of drawing. At a minimum you can subclass and provide drawPixel(). At a maximum you can do a ton of overriding to optimize. Used for any/all Adafruit displays!
 #if defined(LITTLE_FOOT_PRINT)
 class Arduino_GFX : public Print
@@ -289,6 +322,7 @@ public:
   virtual void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
   virtual void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  virtual void writeHLineSpans(const int16_t *spans, uint16_t count, uint16_t color);
   virtual void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
   virtual void endWrite(void);
 
@@ -318,6 +352,11 @@ public:
   void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
   void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
   void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+#if !defined(LITTLE_FOOT_PRINT)
+  void fillPolygon(const int16_t *points, uint16_t n, uint16_t color);
+  void fillTriangleMesh(const int16_t *points, const uint16_t *indices, uint16_t triangles, uint16_t color);
+  void fillTriangleMesh(const int16_t *points, const uint16_t *indices, uint16_t triangles, const uint16_t *colors);
+#endif // !defined(LITTLE_FOOT_PRINT)
   void drawRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h, int16_t radius, uint16_t color);
   void fillRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h, int16_t radius, uint16_t color);
   void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color);
@@ -334,6 +373,12 @@ public:
   void setTextSize(uint8_t s);
   void setTextSize(uint8_t sx, uint8_t sy);
   void setTextSize(uint8_t sx, uint8_t sy, uint8_t pixel_margin);
+#if (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
+  void invalidateTextBoundsCache();
+  void resetTextBoundsCacheStats();
+  uint32_t getTextBoundsCacheHits() const { return _tbc_hits; }
+  uint32_t getTextBoundsCacheMisses() const { return _tbc_misses; }
+#endif // (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
 
 #if !defined(ATTINY_CORE)
   void setFont(const GFXfont *f = NULL);
@@ -394,6 +439,7 @@ public:
   virtual void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg);
 
   virtual void draw16bitBeRGBBitmapR1(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h);
+  virtual bool copyRect(int16_t src_x, int16_t src_y, int16_t dst_x, int16_t dst_y, int16_t w, int16_t h);
 #endif // !defined(LITTLE_FOOT_PRINT)
 
   /**********************************************************************/
@@ -421,6 +467,9 @@ public:
     _min_text_y = y;
     _max_text_x = x + w - 1;
     _max_text_y = y + h - 1;
+#if (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
+    invalidateTextBoundsCache();
+#endif
   }
 
   /**********************************************************************/
@@ -453,7 +502,13 @@ public:
   @param  w  true for wrapping, false for clipping
   */
   /**********************************************************************/
-  void setTextWrap(bool w) { wrap = w; }
+  void setTextWrap(bool w)
+  {
+    wrap = w;
+#if (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
+    invalidateTextBoundsCache();
+#endif
+  }
 
   virtual size_t write(uint8_t);
 
@@ -516,6 +571,38 @@ public:
 
 protected:
   void charBounds(char c, int16_t *x, int16_t *y, int16_t *minx, int16_t *miny, int16_t *maxx, int16_t *maxy);
+#if (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
+  typedef struct
+  {
+    uint32_t hash; ///< FNV-1a hash of the string, picks the slot
+    uint16_t len;  ///< String length, 0 marks an empty slot
+    int16_t x, y;  ///< Cursor position passed to getTextBounds()
+    int16_t x1, y1;
+    uint16_t w, h;
+    char str[GFX_TEXT_BOUNDS_CACHE_MAX_LEN]; ///< The string itself, not terminated
+  } gfx_text_bounds_t;
+
+  bool textBoundsCacheGet(const char *str, bool progmem, uint32_t hash, size_t len, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h);
+  void textBoundsCachePut(const char *str, bool progmem, uint32_t hash, size_t len, int16_t x, int16_t y, int16_t x1, int16_t y1, uint16_t w, uint16_t h);
+  gfx_text_bounds_t _tbc[GFX_TEXT_BOUNDS_CACHE_SIZE];
+  uint32_t _tbc_hits;
+  uint32_t _tbc_misses;
+#endif // (GFX_TEXT_BOUNDS_CACHE_SIZE > 0)
+#if !defined(LITTLE_FOOT_PRINT)
+  typedef struct
+  {
+    int32_t x;      ///< Crossing on the current scanline is x + rem / dy
+    int32_t rem;    ///< 0 <= rem < dy
+    int32_t dx;     ///< Whole part of the x step per scanline
+    int32_t dx_rem; ///< Fractional part of the x step, in 1 / dy units
+    int32_t dy;     ///< Edge height
+    int16_t y0;     ///< First scanline crossed
+    int16_t y1;     ///< Scanline after the last one crossed
+  } gfx_poly_edge_t;
+
+  void writeFillPolygonHelper(const int16_t *points, const uint16_t *indices, uint16_t n, int16_t *spans, uint16_t &span_cnt, uint16_t color);
+  bool copyRectMap(int16_t &src_x, int16_t &src_y, int16_t &dst_x, int16_t &dst_y, int16_t &w, int16_t &h);
+#endif // !defined(LITTLE_FOOT_PRINT)
   int16_t
       _width,  ///< Display width as modified by current rotation
       _height, ///< Display height as modified by current rotation
@@ -36,6 +36,7 @@
 #include "databus/Arduino_SWPAR8.h"
 #include "databus/Arduino_SWPAR16.h"
 #include "databus/Arduino_SWSPI.h"
+#include "databus/Arduino_TraceBus.h"
 #include "databus/Arduino_Wire.h"
 #include "databus/Arduino_XL9535SWSPI.h"
 #include "databus/Arduino_XCA9554SWSPI.h"
@@ -46,6 +47,9 @@
 #include "canvas/Arduino_Canvas_Indexed.h"
 #include "canvas/Arduino_Canvas_3bit.h"
 #include "canvas/Arduino_Canvas_Mono.h"
+#include "canvas/Arduino_Compositor.h"
+#include "canvas/Arduino_DisplayList.h"
+#include "canvas/Arduino_ImageStrip.h"
 #include "display/Arduino_ILI9488_3bit.h"
 #endif // !defined(LITTLE_FOOT_PRINT)
 
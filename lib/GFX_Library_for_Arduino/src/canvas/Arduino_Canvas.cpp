@@ -191,6 +191,38 @@ void Arduino_Canvas::writeFastHLineCore(int16_t x, int16_t y,
   }
 }
 
+void Arduino_Canvas::writeHLineSpans(const int16_t *spans, uint16_t count, uint16_t color)
+{
+  // log_i("writeHLineSpans(count: %d)", count);
+  const int16_t *end = spans + (count * 3);
+  switch (_rotation)
+  {
+  case 1:
+    for (; spans < end; spans += 3)
+    {
+      writeFastVLineCore(_max_y - spans[1], spans[0], spans[2], color);
+    }
+    break;
+  case 2:
+    for (; spans < end; spans += 3)
+    {
+      writeFastHLineCore(_width - spans[0] - spans[2], _max_y - spans[1], spans[2], color);
+    }
+    break;
+  case 3:
+    for (; spans < end; spans += 3)
+    {
+      writeFastVLineCore(spans[1], _width - spans[0] - spans[2], spans[2], color);
+    }
+    break;
+  default: // case 0:
+    for (; spans < end; spans += 3)
+    {
+      writeFastHLineCore(spans[0], spans[1], spans[2], color);
+    }
+  }
+}
+
 void Arduino_Canvas::writeFillRectPreclipped(int16_t x, int16_t y,
                                              int16_t w, int16_t h, uint16_t color)
 {
@@ -653,6 +685,19 @@ void Arduino_Canvas::shade(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t
   }
 }
 
+bool Arduino_Canvas::copyRect(int16_t src_x, int16_t src_y, int16_t dst_x, int16_t dst_y, int16_t w, int16_t h)
+{
+  if (!_framebuffer)
+  {
+    return false;
+  }
+  if (copyRectMap(src_x, src_y, dst_x, dst_y, w, h))
+  {
+    gfx_copy_rect16(_framebuffer, WIDTH, src_x, src_y, dst_x, dst_y, w, h);
+  }
+  return true;
+}
+
 uint16_t *Arduino_Canvas::getFramebuffer()
 {
   return _framebuffer;
@@ -0,0 +1,389 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#include "../Arduino_GFX.h"
+#include "Arduino_Compositor.h"
+
+Arduino_Compositor::Arduino_Compositor(
+    int16_t w, int16_t h, Arduino_G *output, int16_t output_x, int16_t output_y)
+    : _output(output), _output_x(output_x), _output_y(output_y), _width(w), _height(h)
+{
+}
+
+Arduino_Compositor::~Arduino_Compositor()
+{
+  if (_buffer)
+  {
+    free(_buffer);
+  }
+}
+
+bool Arduino_Compositor::begin(int32_t speed)
+{
+  if (
+      (speed != GFX_SKIP_OUTPUT_BEGIN) && (_output))
+  {
+    if (!_output->begin(speed))
+    {
+      return false;
+    }
+  }
+
+  if (!_buffer)
+  {
+    size_t s = _width * _height * 2;
+#if defined(ESP32)
+    _buffer = (uint16_t *)aligned_alloc(16, s);
+#else
+    _buffer = (uint16_t *)malloc(s);
+#endif
+    if (!_buffer)
+    {
+      return false;
+    }
+  }
+
+  invalidate(0, 0, _width, _height);
+
+  return true;
+}
+
+/**
+ * @brief addLayer
+ *
+ * Layers are stacked in the order they are added, the last one on top. The
+ * pixels (and alpha plane) are used in place and must outlive the layer.
+ *
+ * @param pixels RGB565 pixels, w * h
+ * @param alpha 8-bit alpha per pixel, w * h, or nullptr for an opaque layer
+ * @return layer id, or -1 when GFX_COMPOSITOR_LAYERS are already in use
+ */
+int8_t Arduino_Compositor::addLayer(uint16_t *pixels, uint8_t *alpha, int16_t w, int16_t h, int16_t x, int16_t y)
+{
+  if ((!pixels) || (_layer_count >= GFX_COMPOSITOR_LAYERS))
+  {
+    return -1;
+  }
+
+  gfx_layer_t *l = &_layers[_layer_count];
+  l->pixels = pixels;
+  l->alpha = alpha;
+  l->x = x;
+  l->y = y;
+  l->w = w;
+  l->h = h;
+  l->opacity = 255;
+  l->visible = true;
+  invalidate(x, y, w, h);
+
+  return _layer_count++;
+}
+
+// The canvas must be begun and left at rotation 0, its framebuffer is the layer
+int8_t Arduino_Compositor::addLayer(Arduino_Canvas *canvas, uint8_t *alpha, int16_t x, int16_t y)
+{
+  return addLayer(canvas->getFramebuffer(), alpha, canvas->width(), canvas->height(), x, y);
+}
+
+// nullptr for ids addLayer() did not return, the layer setters ignore those
+gfx_layer_t *Arduino_Compositor::getLayer(int8_t layer)
+{
+  if ((layer < 0) || (layer >= _layer_count))
+  {
+    return nullptr;
+  }
+  return &_layers[layer];
+}
+
+void Arduino_Compositor::moveLayer(int8_t layer, int16_t x, int16_t y)
+{
+  gfx_layer_t *l = getLayer(layer);
+  if (!l)
+  {
+    return;
+  }
+  if ((x != l->x) || (y != l->y))
+  {
+    if (l->visible)
+    {
+      invalidate(l->x, l->y, l->w, l->h);
+      invalidate(x, y, l->w, l->h);
+    }
+    l->x = x;
+    l->y = y;
+  }
+}
+
+void Arduino_Compositor::setLayerVisible(int8_t layer, bool visible)
+{
+  gfx_layer_t *l = getLayer(layer);
+  if (!l)
+  {
+    return;
+  }
+  if (visible != l->visible)
+  {
+    l->visible = visible;
+    invalidate(l->x, l->y, l->w, l->h);
+  }
+}
+
+void Arduino_Compositor::setLayerOpacity(int8_t layer, uint8_t opacity)
+{
+  gfx_layer_t *l = getLayer(layer);
+  if (!l)
+  {
+    return;
+  }
+  if (opacity != l->opacity)
+  {
+    l->opacity = opacity;
+    if (l->visible)
+    {
+      invalidate(l->x, l->y, l->w, l->h);
+    }
+  }
+}
+
+// Call after drawing into a layer's pixels
+void Arduino_Compositor::invalidateLayer(int8_t layer)
+{
+  gfx_layer_t *l = getLayer(layer);
+  if (!l)
+  {
+    return;
+  }
+  invalidateLayer(layer, 0, 0, l->w, l->h);
+}
+
+void Arduino_Compositor::invalidateLayer(int8_t layer, int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  gfx_layer_t *l = getLayer(layer);
+  if (!l)
+  {
+    return;
+  }
+  if (l->visible)
+  {
+    invalidate(l->x + x, l->y + y, w, h);
+  }
+}
+
+void Arduino_Compositor::invalidate(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  // clip to the output area
+  if (x < 0)
+  {
+    w += x;
+    x = 0;
+  }
+  if (y < 0)
+  {
+    h += y;
+    y = 0;
+  }
+  if ((x + w) > _width)
+  {
+    w = _width - x;
+  }
+  if ((y + h) > _height)
+  {
+    h = _height - y;
+  }
+  if ((w <= 0) || (h <= 0))
+  {
+    return;
+  }
+
+  // merge with every overlapping rectangle, repeat as the union grows
+  gfx_rect_t n = {x, y, w, h};
+  uint8_t i = 0;
+  while (i < _dirty_count)
+  {
+    gfx_rect_t *d = &_dirty[i];
+    if ((n.x < (d->x + d->w)) && (d->x < (n.x + n.w)) && (n.y < (d->y + d->h)) && (d->y < (n.y + n.h)))
+    {
+      int16_t x2 = max(n.x + n.w, d->x + d->w);
+      int16_t y2 = max(n.y + n.h, d->y + d->h);
+      n.x = min(n.x, d->x);
+      n.y = min(n.y, d->y);
+      n.w = x2 - n.x;
+      n.h = y2 - n.y;
+      _dirty[i] = _dirty[--_dirty_count];
+      i = 0;
+    }
+    else
+    {
+      ++i;
+    }
+  }
+
+  if (_dirty_count >= GFX_COMPOSITOR_DIRTY_RECTS)
+  {
+    // out of slots, fall back to one bounding box
+    for (i = 0; i < _dirty_count; ++i)
+    {
+      gfx_rect_t *d = &_dirty[i];
+      int16_t x2 = max(n.x + n.w, d->x + d->w);
+      int16_t y2 = max(n.y + n.h, d->y + d->h);
+      n.x = min(n.x, d->x);
+      n.y = min(n.y, d->y);
+      n.w = x2 - n.x;
+      n.h = y2 - n.y;
+    }
+    _dirty_count = 0;
+  }
+  _dirty[_dirty_count++] = n;
+}
+
+void Arduino_Compositor::setBackground(uint16_t color)
+{
+  if (color != _background)
+  {
+    _background = color;
+    invalidate(0, 0, _width, _height);
+  }
+}
+
+/**
+ * @brief flush
+ *
+ * Compose every dirty rectangle from the layers and draw it to the output,
+ * one draw16bitRGBBitmap() call per rectangle.
+ */
+void Arduino_Compositor::flush()
+{
+  if (_output && _buffer)
+  {
+    for (uint8_t i = 0; i < _dirty_count; ++i)
+    {
+      gfx_rect_t *r = &_dirty[i];
+      composeRect(r, _buffer);
+      _output->draw16bitRGBBitmap(_output_x + r->x, _output_y + r->y, _buffer, r->w, r->h);
+    }
+  }
+  _dirty_count = 0;
+}
+
+uint8_t Arduino_Compositor::getDirtyCount()
+{
+  return _dirty_count;
+}
+
+// Compose one rectangle into buf, rows packed at r->w pixels
+void Arduino_Compositor::composeRect(const gfx_rect_t *r, uint16_t *buf)
+{
+  int16_t rx2 = r->x + r->w;
+  int16_t ry2 = r->y + r->h;
+
+  // layers under an opaque one covering the whole rectangle never show
+  int8_t first = -1;
+  for (int8_t i = _layer_count - 1; i >= 0; --i)
+  {
+    gfx_layer_t *l = &_layers[i];
+    if (
+        l->visible && (!l->alpha) && (l->opacity == 255) &&
+        (l->x <= r->x) && (l->y <= r->y) && ((l->x + l->w) >= rx2) && ((l->y + l->h) >= ry2))
+    {
+      first = i;
+      break;
+    }
+  }
+  if (first < 0)
+  {
+    uint16_t *p = buf;
+    uint32_t len = (uint32_t)r->w * r->h;
+    while (len--)
+    {
+      *p++ = _background;
+    }
+    first = 0;
+  }
+
+  for (uint8_t i = first; i < _layer_count; ++i)
+  {
+    gfx_layer_t *l = &_layers[i];
+    if (!l->visible)
+    {
+      continue;
+    }
+    int16_t x1 = max(r->x, l->x);
+    int16_t y1 = max(r->y, l->y);
+    int16_t x2 = min(rx2, (int16_t)(l->x + l->w));
+    int16_t y2 = min(ry2, (int16_t)(l->y + l->h));
+    if ((x1 >= x2) || (y1 >= y2))
+    {
+      continue;
+    }
+
+    int16_t w = x2 - x1;
+    int32_t src_offset = ((int32_t)(y1 - l->y) * l->w) + (x1 - l->x);
+    uint16_t *src = l->pixels + src_offset;
+    uint8_t *alpha = l->alpha ? (l->alpha + src_offset) : nullptr;
+    uint16_t *dst = buf + ((int32_t)(y1 - r->y) * r->w) + (x1 - r->x);
+    for (int16_t y = y1; y < y2; ++y)
+    {
+      blendRow(dst, src, alpha, w, l->opacity);
+      src += l->w;
+      if (alpha)
+      {
+        alpha += l->w;
+      }
+      dst += r->w;
+    }
+  }
+}
+
+void Arduino_Compositor::blendRow(uint16_t *dst, const uint16_t *src, const uint8_t *alpha, int16_t w, uint8_t opacity)
+{
+  if (!alpha)
+  {
+    uint8_t a32 = (opacity + 4) >> 3;
+    if (a32 >= 32)
+    {
+      memcpy(dst, src, w * 2);
+    }
+    else if (a32)
+    {
+      while (w--)
+      {
+        *dst = gfx_blend565(*src++, *dst, a32);
+        ++dst;
+      }
+    }
+  }
+  else if (opacity == 255)
+  {
+    uint8_t a;
+    while (w--)
+    {
+      a = *alpha++;
+      if (a == 255)
+      {
+        *dst = *src;
+      }
+      else if (a)
+      {
+        *dst = gfx_blend565(*src, *dst, (a + 4) >> 3);
+      }
+      ++src;
+      ++dst;
+    }
+  }
+  else
+  {
+    uint16_t a;
+    while (w--)
+    {
+      a = ((*alpha++ * opacity) + 255) >> 8;
+      if (a)
+      {
+        *dst = gfx_blend565(*src, *dst, (a + 4) >> 3);
+      }
+      ++src;
+      ++dst;
+    }
+  }
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -0,0 +1,87 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef _ARDUINO_COMPOSITOR_H_
+#define _ARDUINO_COMPOSITOR_H_
+
+#include "../Arduino_GFX.h"
+#include "Arduino_Canvas.h"
+
+// Maximum number of stacked layers
+#ifndef GFX_COMPOSITOR_LAYERS
+#define GFX_COMPOSITOR_LAYERS 8
+#endif
+
+// Dirty rectangles tracked between flushes, more are merged into their bounding box
+#ifndef GFX_COMPOSITOR_DIRTY_RECTS
+#define GFX_COMPOSITOR_DIRTY_RECTS 8
+#endif
+
+typedef struct
+{
+  uint16_t *pixels; // RGB565, w * h
+  uint8_t *alpha;   // A8 plane, w * h, nullptr for an opaque layer
+  int16_t x, y, w, h;
+  uint8_t opacity; // whole layer alpha, multiplied with the A8 plane
+  bool visible;
+} gfx_layer_t;
+
+typedef struct
+{
+  int16_t x, y, w, h;
+} gfx_rect_t;
+
+// Blend fg over bg with alpha 0 - 32, spreading R, G and B apart in one 32-bit word
+// so a single multiply blends all three channels
+GFX_INLINE uint16_t gfx_blend565(uint16_t fg, uint16_t bg, uint8_t alpha32)
+{
+  uint32_t fg32 = (fg | ((uint32_t)fg << 16)) & 0x07E0F81F;
+  uint32_t bg32 = (bg | ((uint32_t)bg << 16)) & 0x07E0F81F;
+  uint32_t r = ((((fg32 - bg32) * alpha32) >> 5) + bg32) & 0x07E0F81F;
+  return (uint16_t)((r >> 16) | r);
+}
+
+/// Stacks RGB565 layers with optional 8-bit alpha and redraws only the areas that changed
+class Arduino_Compositor
+{
+public:
+  Arduino_Compositor(int16_t w, int16_t h, Arduino_G *output, int16_t output_x = 0, int16_t output_y = 0);
+  ~Arduino_Compositor();
+
+  bool begin(int32_t speed = GFX_NOT_DEFINED);
+
+  int8_t addLayer(uint16_t *pixels, uint8_t *alpha, int16_t w, int16_t h, int16_t x = 0, int16_t y = 0);
+  int8_t addLayer(Arduino_Canvas *canvas, uint8_t *alpha = nullptr, int16_t x = 0, int16_t y = 0);
+  void moveLayer(int8_t layer, int16_t x, int16_t y);
+  void setLayerVisible(int8_t layer, bool visible);
+  void setLayerOpacity(int8_t layer, uint8_t opacity);
+  void invalidateLayer(int8_t layer);
+  void invalidateLayer(int8_t layer, int16_t x, int16_t y, int16_t w, int16_t h);
+  void invalidate(int16_t x, int16_t y, int16_t w, int16_t h);
+  void setBackground(uint16_t color);
+
+  void flush();
+  uint8_t getDirtyCount();
+
+protected:
+  gfx_layer_t *getLayer(int8_t layer);
+  void composeRect(const gfx_rect_t *r, uint16_t *buf);
+  void blendRow(uint16_t *dst, const uint16_t *src, const uint8_t *alpha, int16_t w, uint8_t opacity);
+
+  Arduino_G *_output;
+  int16_t _output_x, _output_y;
+  int16_t _width, _height;
+  uint16_t *_buffer = nullptr;
+  uint16_t _background = 0;
+
+  gfx_layer_t _layers[GFX_COMPOSITOR_LAYERS];
+  uint8_t _layer_count = 0;
+  gfx_rect_t _dirty[GFX_COMPOSITOR_DIRTY_RECTS];
+  uint8_t _dirty_count = 0;
+
+private:
+};
+
+#endif // _ARDUINO_COMPOSITOR_H_
+
+#endif // !defined(LITTLE_FOOT_PRINT)
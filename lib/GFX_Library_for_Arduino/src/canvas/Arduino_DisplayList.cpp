@@ -0,0 +1,426 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#include "../Arduino_GFX.h"
+#include "Arduino_DisplayList.h"
+
+static inline bool gfx_dl_overlap(const gfx_dl_op_t *a, const gfx_dl_op_t *b)
+{
+  return (a->x < (b->x + b->w)) && (b->x < (a->x + a->w)) && (a->y < (b->y + b->h)) && (b->y < (a->y + a->h));
+}
+
+static inline bool gfx_dl_contains(const gfx_dl_op_t *outer, const gfx_dl_op_t *inner)
+{
+  return (inner->x >= outer->x) && (inner->y >= outer->y) && ((inner->x + inner->w) <= (outer->x + outer->w)) && ((inner->y + inner->h) <= (outer->y + outer->h));
+}
+
+Arduino_DisplayList::Arduino_DisplayList(
+    int16_t w, int16_t h, Arduino_GFX *output, int16_t output_x, int16_t output_y, uint16_t capacity)
+    : Arduino_GFX(w, h), _output(output), _output_x(output_x), _output_y(output_y), _capacity(capacity)
+{
+}
+
+Arduino_DisplayList::~Arduino_DisplayList()
+{
+  if (_ops)
+  {
+    free(_ops);
+  }
+}
+
+bool Arduino_DisplayList::begin(int32_t speed)
+{
+  if (
+      (speed != GFX_SKIP_OUTPUT_BEGIN) && (_output))
+  {
+    if (!_output->begin(speed))
+    {
+      return false;
+    }
+  }
+
+  if (!_ops)
+  {
+    if (_capacity == 0)
+    {
+      return false;
+    }
+    _ops = (gfx_dl_op_t *)malloc(sizeof(gfx_dl_op_t) * _capacity);
+    if (!_ops)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void Arduino_DisplayList::writePixelPreclipped(int16_t x, int16_t y, uint16_t color)
+{
+  recordFill(x, y, 1, 1, color);
+}
+
+void Arduino_DisplayList::writeFastVLine(int16_t x, int16_t y,
+                                         int16_t h, uint16_t color)
+{
+  if (_ordered_in_range(x, 0, _max_x) && h)
+  { // X on screen, nonzero height
+    if (h < 0)
+    {             // If negative height...
+      y += h + 1; //   Move Y to top edge
+      h = -h;     //   Use positive height
+    }
+    if (y <= _max_y)
+    { // Not off bottom
+      int16_t y2 = y + h - 1;
+      if (y2 >= 0)
+      { // Not off top
+        // Line partly or fully overlaps screen
+        if (y < 0)
+        {
+          y = 0;
+          h = y2 + 1;
+        } // Clip top
+        if (y2 > _max_y)
+        {
+          h = _max_y - y + 1;
+        } // Clip bottom
+
+        recordFill(x, y, 1, h, color);
+      }
+    }
+  }
+}
+
+void Arduino_DisplayList::writeFastHLine(int16_t x, int16_t y,
+                                         int16_t w, uint16_t color)
+{
+  if (_ordered_in_range(y, 0, _max_y) && w)
+  { // Y on screen, nonzero width
+    if (w < 0)
+    {             // If negative width...
+      x += w + 1; //   Move X to left edge
+      w = -w;     //   Use positive width
+    }
+    if (x <= _max_x)
+    { // Not off right
+      int16_t x2 = x + w - 1;
+      if (x2 >= 0)
+      { // Not off left
+        // Line partly or fully overlaps screen
+        if (x < 0)
+        {
+          x = 0;
+          w = x2 + 1;
+        } // Clip left
+        if (x2 > _max_x)
+        {
+          w = _max_x - x + 1;
+        } // Clip right
+
+        recordFill(x, y, w, 1, color);
+      }
+    }
+  }
+}
+
+void Arduino_DisplayList::writeFillRectPreclipped(int16_t x, int16_t y,
+                                                  int16_t w, int16_t h, uint16_t color)
+{
+  recordFill(x, y, w, h, color);
+}
+
+/**
+ * @brief draw16bitRGBBitmap
+ *
+ * Only the bitmap pointer is recorded, the pixels must stay unchanged until
+ * the next flush().
+ */
+void Arduino_DisplayList::draw16bitRGBBitmap(int16_t x, int16_t y,
+                                             uint16_t *bitmap, int16_t w, int16_t h)
+{
+  if (
+      (w <= 0) || (h <= 0) ||
+      ((x + w - 1) < 0) || // Outside left
+      ((y + h - 1) < 0) || // Outside top
+      (x > _max_x) ||      // Outside right
+      (y > _max_y)         // Outside bottom
+  )
+  {
+    return;
+  }
+
+  int16_t stride = w;
+  if (y < 0)
+  {
+    bitmap -= (int32_t)y * stride;
+    h += y;
+    y = 0;
+  }
+  if ((y + h - 1) > _max_y)
+  {
+    h = _max_y - y + 1;
+  }
+  if (x < 0)
+  {
+    bitmap -= x;
+    w += x;
+    x = 0;
+  }
+  if ((x + w - 1) > _max_x)
+  {
+    w = _max_x - x + 1;
+  }
+
+  if (_bitmap_count >= GFX_DISPLAY_LIST_BITMAPS)
+  {
+    flush();
+  }
+  if ((x == 0) && (y == 0) && (w == _width) && (h == _height))
+  {
+    clear(); // everything recorded so far is covered
+  }
+
+  gfx_dl_op_t *op = allocOp();
+  op->x = x;
+  op->y = y;
+  op->w = w;
+  op->h = h;
+  op->color = _bitmap_count;
+  op->type = GFX_DL_BITMAP;
+  _bitmaps[_bitmap_count].bitmap = bitmap;
+  _bitmaps[_bitmap_count].stride = stride;
+  ++_bitmap_count;
+}
+
+/**
+ * @brief flush
+ *
+ * Replay the recorded list to the output and start a new one. Operations
+ * fully covered by later ones are dropped, the rest are reordered top to
+ * bottom where they do not overlap, and touching fills of one color are
+ * merged into a single address window.
+ */
+void Arduino_DisplayList::flush(bool force_flush)
+{
+  if (_output && _count)
+  {
+    cullCovered();
+    sortRows();
+    replay();
+  }
+  clear();
+}
+
+void Arduino_DisplayList::clear()
+{
+  _count = 0;
+  _bitmap_count = 0;
+}
+
+uint16_t Arduino_DisplayList::getCount()
+{
+  return _count;
+}
+
+void Arduino_DisplayList::recordFill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  if ((x == 0) && (y == 0) && (w == _width) && (h == _height))
+  {
+    clear(); // e.g. fillScreen(), everything recorded so far is covered
+  }
+  else if (_count)
+  {
+    // extend the previous fill when this one continues it
+    gfx_dl_op_t *last = &_ops[_count - 1];
+    if ((last->type == GFX_DL_FILL) && (last->color == color))
+    {
+      if ((y == last->y) && (h == last->h) && (x == (last->x + last->w)))
+      {
+        last->w += w;
+        return;
+      }
+      if ((x == last->x) && (w == last->w) && (y == (last->y + last->h)))
+      {
+        last->h += h;
+        return;
+      }
+    }
+  }
+
+  gfx_dl_op_t *op = allocOp();
+  op->x = x;
+  op->y = y;
+  op->w = w;
+  op->h = h;
+  op->color = color;
+  op->type = GFX_DL_FILL;
+}
+
+gfx_dl_op_t *Arduino_DisplayList::allocOp()
+{
+  if (_count >= _capacity)
+  {
+    flush();
+  }
+  return &_ops[_count++];
+}
+
+// Walk the list backwards keeping the largest operations seen so far, any
+// operation inside one of them is overdrawn before it reaches the screen.
+void Arduino_DisplayList::cullCovered()
+{
+  gfx_dl_op_t occluders[GFX_DISPLAY_LIST_OCCLUDERS];
+  int32_t areas[GFX_DISPLAY_LIST_OCCLUDERS];
+  uint8_t occluder_count = 0;
+
+  for (int32_t i = _count - 1; i >= 0; --i)
+  {
+    gfx_dl_op_t *op = &_ops[i];
+    bool covered = false;
+    for (uint8_t k = 0; k < occluder_count; ++k)
+    {
+      if (gfx_dl_contains(&occluders[k], op))
+      {
+        covered = true;
+        break;
+      }
+    }
+    if (covered)
+    {
+      op->type = GFX_DL_NONE;
+      continue;
+    }
+
+    // fills and 16-bit bitmaps are both opaque
+    int32_t area = (int32_t)op->w * op->h;
+    if (occluder_count < GFX_DISPLAY_LIST_OCCLUDERS)
+    {
+      occluders[occluder_count] = *op;
+      areas[occluder_count++] = area;
+    }
+    else
+    {
+      uint8_t smallest = 0;
+      for (uint8_t k = 1; k < GFX_DISPLAY_LIST_OCCLUDERS; ++k)
+      {
+        if (areas[k] < areas[smallest])
+        {
+          smallest = k;
+        }
+      }
+      if (area > areas[smallest])
+      {
+        occluders[smallest] = *op;
+        areas[smallest] = area;
+      }
+    }
+  }
+
+  uint16_t kept = 0;
+  for (uint16_t i = 0; i < _count; ++i)
+  {
+    if (_ops[i].type != GFX_DL_NONE)
+    {
+      _ops[kept++] = _ops[i];
+    }
+  }
+  _count = kept;
+}
+
+// Insertion sort by (y, x). An operation never moves past one it overlaps,
+// so the painted result is the same as the recorded order.
+void Arduino_DisplayList::sortRows()
+{
+  for (uint16_t i = 1; i < _count; ++i)
+  {
+    gfx_dl_op_t op = _ops[i];
+    uint16_t j = i;
+    uint16_t limit = (i > GFX_DISPLAY_LIST_SORT_WINDOW) ? (i - GFX_DISPLAY_LIST_SORT_WINDOW) : 0;
+    while (j > limit)
+    {
+      gfx_dl_op_t *prev = &_ops[j - 1];
+      if ((prev->y < op.y) || ((prev->y == op.y) && (prev->x <= op.x)))
+      {
+        break; // already in order
+      }
+      if (gfx_dl_overlap(prev, &op))
+      {
+        break;
+      }
+      _ops[j] = *prev;
+      --j;
+    }
+    _ops[j] = op;
+  }
+}
+
+void Arduino_DisplayList::replay()
+{
+  bool writing = false;
+  uint16_t i = 0;
+  while (i < _count)
+  {
+    gfx_dl_op_t op = _ops[i++];
+    if (op.type == GFX_DL_FILL)
+    {
+      // sorting may have brought touching fills next to each other
+      while (i < _count)
+      {
+        gfx_dl_op_t *next = &_ops[i];
+        if ((next->type != GFX_DL_FILL) || (next->color != op.color))
+        {
+          break;
+        }
+        if ((next->y == op.y) && (next->h == op.h) && (next->x == (op.x + op.w)))
+        {
+          op.w += next->w;
+        }
+        else if ((next->x == op.x) && (next->w == op.w) && (next->y == (op.y + op.h)))
+        {
+          op.h += next->h;
+        }
+        else
+        {
+          break;
+        }
+        ++i;
+      }
+
+      if (!writing)
+      {
+        _output->startWrite();
+        writing = true;
+      }
+      _output->writeFillRect(_output_x + op.x, _output_y + op.y, op.w, op.h, op.color);
+    }
+    else // GFX_DL_BITMAP
+    {
+      if (writing)
+      {
+        _output->endWrite();
+        writing = false;
+      }
+      gfx_dl_bitmap_t *b = &_bitmaps[op.color];
+      if (b->stride == op.w)
+      {
+        _output->draw16bitRGBBitmap(_output_x + op.x, _output_y + op.y, b->bitmap, op.w, op.h);
+      }
+      else
+      {
+        uint16_t *row = b->bitmap;
+        for (int16_t j = 0; j < op.h; ++j)
+        {
+          _output->draw16bitRGBBitmap(_output_x + op.x, _output_y + op.y + j, row, op.w, 1);
+          row += b->stride;
+        }
+      }
+    }
+  }
+  if (writing)
+  {
+    _output->endWrite();
+  }
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
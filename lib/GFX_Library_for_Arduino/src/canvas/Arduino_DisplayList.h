@@ -0,0 +1,85 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef _ARDUINO_DISPLAYLIST_H_
+#define _ARDUINO_DISPLAYLIST_H_
+
+#include "../Arduino_GFX.h"
+
+// Default number of recorded operations, a full list is replayed automatically
+#ifndef GFX_DISPLAY_LIST_SIZE
+#define GFX_DISPLAY_LIST_SIZE 512
+#endif
+
+// Number of 16-bit bitmaps referenced by one list
+#ifndef GFX_DISPLAY_LIST_BITMAPS
+#define GFX_DISPLAY_LIST_BITMAPS 16
+#endif
+
+// Largest later operations kept while looking for fully covered ones
+#ifndef GFX_DISPLAY_LIST_OCCLUDERS
+#define GFX_DISPLAY_LIST_OCCLUDERS 8
+#endif
+
+// How far an operation may move up the list while sorting
+#ifndef GFX_DISPLAY_LIST_SORT_WINDOW
+#define GFX_DISPLAY_LIST_SORT_WINDOW 32
+#endif
+
+#define GFX_DL_NONE 0
+#define GFX_DL_FILL 1
+#define GFX_DL_BITMAP 2
+
+typedef struct
+{
+  int16_t x, y, w, h;
+  uint16_t color; // fill color, or _bitmaps index for GFX_DL_BITMAP
+  uint8_t type;
+  uint8_t reserved;
+} gfx_dl_op_t;
+
+typedef struct
+{
+  uint16_t *bitmap; // first visible pixel
+  int16_t stride;   // source bitmap width
+} gfx_dl_bitmap_t;
+
+/// Records drawing as a list of clipped rectangles and bitmaps, flush() replays it to the output display
+class Arduino_DisplayList : public Arduino_GFX
+{
+public:
+  Arduino_DisplayList(int16_t w, int16_t h, Arduino_GFX *output, int16_t output_x = 0, int16_t output_y = 0, uint16_t capacity = GFX_DISPLAY_LIST_SIZE);
+  ~Arduino_DisplayList();
+
+  bool begin(int32_t speed = GFX_NOT_DEFINED) override;
+  void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override;
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
+  void flush(bool force_flush = false) override;
+
+  void clear();
+  uint16_t getCount();
+
+protected:
+  void recordFill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  gfx_dl_op_t *allocOp();
+  void cullCovered();
+  void sortRows();
+  void replay();
+
+  Arduino_GFX *_output = nullptr;
+  int16_t _output_x, _output_y;
+  gfx_dl_op_t *_ops = nullptr;
+  uint16_t _capacity;
+  uint16_t _count = 0;
+  gfx_dl_bitmap_t _bitmaps[GFX_DISPLAY_LIST_BITMAPS];
+  uint16_t _bitmap_count = 0;
+
+private:
+};
+
+#endif // _ARDUINO_DISPLAYLIST_H_
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -0,0 +1,221 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#include "../Arduino_G.h"
+#include "Arduino_ImageStrip.h"
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define GFX_IMAGE_STRIP_WORD_READS
+#endif
+
+GFX_INLINE static uint16_t gfx_pack565(uint8_t r, uint8_t g, uint8_t b, bool big_endian)
+{
+  uint16_t c = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+  return big_endian ? ((c >> 8) | (c << 8)) : c;
+}
+
+void gfx_bgr888_to_rgb565(const uint8_t *src, uint16_t *dst, int16_t w, bool big_endian)
+{
+#if defined(GFX_IMAGE_STRIP_WORD_READS)
+  if (((uintptr_t)src & 3) == 0)
+  {
+    // 4 pixels in 3 words: B0 G0 R0 B1 | G1 R1 B2 G2 | R2 B3 G3 R3
+    const uint32_t *s = (const uint32_t *)src;
+    while (w >= 4)
+    {
+      uint32_t w0 = *s++;
+      uint32_t w1 = *s++;
+      uint32_t w2 = *s++;
+      *dst++ = gfx_pack565(w0 >> 16, w0 >> 8, w0, big_endian);
+      *dst++ = gfx_pack565(w1 >> 8, w1, w0 >> 24, big_endian);
+      *dst++ = gfx_pack565(w2, w1 >> 24, w1 >> 16, big_endian);
+      *dst++ = gfx_pack565(w2 >> 24, w2 >> 16, w2 >> 8, big_endian);
+      w -= 4;
+    }
+    src = (const uint8_t *)s;
+  }
+#endif
+  while (w--)
+  {
+    *dst++ = gfx_pack565(src[2], src[1], src[0], big_endian);
+    src += 3;
+  }
+}
+
+void gfx_bgrx8888_to_rgb565(const uint8_t *src, uint16_t *dst, int16_t w, bool big_endian)
+{
+#if defined(GFX_IMAGE_STRIP_WORD_READS)
+  if (((uintptr_t)src & 3) == 0)
+  {
+    const uint32_t *s = (const uint32_t *)src;
+    while (w--)
+    {
+      uint32_t p = *s++;
+      *dst++ = gfx_pack565(p >> 16, p >> 8, p, big_endian);
+    }
+    return;
+  }
+#endif
+  while (w--)
+  {
+    *dst++ = gfx_pack565(src[2], src[1], src[0], big_endian);
+    src += 4;
+  }
+}
+
+void gfx_rgb565le_to_rgb565(const uint8_t *src, uint16_t *dst, int16_t w, bool big_endian)
+{
+#if defined(GFX_IMAGE_STRIP_WORD_READS)
+  if (!big_endian)
+  {
+    memcpy(dst, src, w * 2);
+    return;
+  }
+#endif
+  while (w--)
+  {
+    *dst++ = big_endian ? ((src[0] << 8) | src[1]) : (src[0] | (src[1] << 8));
+    src += 2;
+  }
+}
+
+void gfx_indexed_to_rgb565(const uint8_t *src, uint16_t *dst, int16_t w, uint8_t bpp, const uint16_t *palette)
+{
+  if (bpp == 8)
+  {
+    while (w--)
+    {
+      *dst++ = palette[*src++];
+    }
+  }
+  else if (bpp == 4)
+  {
+    while (w >= 2)
+    {
+      uint8_t d = *src++;
+      *dst++ = palette[d >> 4];
+      *dst++ = palette[d & 0x0F];
+      w -= 2;
+    }
+    if (w)
+    {
+      *dst = palette[*src >> 4];
+    }
+  }
+  else
+  {
+    uint8_t mask = (1 << bpp) - 1;
+    uint8_t shift = 0;
+    uint8_t d = 0;
+    while (w--)
+    {
+      if (shift == 0)
+      {
+        d = *src++;
+        shift = 8;
+      }
+      shift -= bpp;
+      *dst++ = palette[(d >> shift) & mask];
+    }
+  }
+}
+
+Arduino_ImageStrip::Arduino_ImageStrip(Arduino_G *output, int16_t w, int16_t rows)
+    : _output(output), _width(w), _rows(rows)
+{
+}
+
+Arduino_ImageStrip::~Arduino_ImageStrip()
+{
+  if (_buffer)
+  {
+    free(_buffer);
+  }
+}
+
+bool Arduino_ImageStrip::begin()
+{
+  if (!_buffer)
+  {
+    if ((_width <= 0) || (_rows <= 0))
+    {
+      return false;
+    }
+    size_t s = (size_t)_width * _rows * 2;
+#if defined(ESP32)
+    _buffer = (uint16_t *)aligned_alloc(16, s);
+#else
+    _buffer = (uint16_t *)malloc(s);
+#endif
+    if (!_buffer)
+    {
+      return false;
+    }
+  }
+  _filled = 0;
+  return true;
+}
+
+/**
+ * @brief start
+ *
+ * Begin a new image. Rows arrive one below the other from (x, y), or one
+ * above the other when bottom_up is set, e.g. for BMP files where y is then
+ * the position of the bottom row.
+ */
+void Arduino_ImageStrip::start(int16_t x, int16_t y, bool bottom_up)
+{
+  flush();
+  _x = x;
+  _y = y;
+  _bottom_up = bottom_up;
+}
+
+/**
+ * @brief nextRow
+ *
+ * @return buffer for the next image row, width() pixels, valid until the
+ * following nextRow() or flush() call
+ */
+uint16_t *Arduino_ImageStrip::nextRow()
+{
+  if (_filled >= _rows)
+  {
+    flush();
+  }
+  int16_t row = _bottom_up ? (_rows - 1 - _filled) : _filled;
+  ++_filled;
+  return _buffer + ((int32_t)row * _width);
+}
+
+void Arduino_ImageStrip::flush()
+{
+  if (_filled == 0)
+  {
+    return;
+  }
+  if (_bottom_up)
+  {
+    // the filled rows are the last ones of the buffer, already top to bottom
+    _output->draw16bitRGBBitmap(_x, _y - _filled + 1, _buffer + ((int32_t)(_rows - _filled) * _width), _width, _filled);
+    _y -= _filled;
+  }
+  else
+  {
+    _output->draw16bitRGBBitmap(_x, _y, _buffer, _width, _filled);
+    _y += _filled;
+  }
+  _filled = 0;
+}
+
+int16_t Arduino_ImageStrip::width()
+{
+  return _width;
+}
+
+int16_t Arduino_ImageStrip::rows()
+{
+  return _rows;
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
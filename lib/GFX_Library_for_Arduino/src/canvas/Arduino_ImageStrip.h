@@ -0,0 +1,50 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef _ARDUINO_IMAGESTRIP_H_
+#define _ARDUINO_IMAGESTRIP_H_
+
+#include "../Arduino_G.h"
+
+// Image rows collected before one draw16bitRGBBitmap() call
+#ifndef GFX_IMAGE_STRIP_ROWS
+#define GFX_IMAGE_STRIP_ROWS 16
+#endif
+
+// Row converters from common file pixel formats to RGB565, dst holds w pixels.
+// Sources starting on a 4-byte boundary (e.g. BMP rows in a malloc'ed block) are read a word at a time.
+void gfx_bgr888_to_rgb565(const uint8_t *src, uint16_t *dst, int16_t w, bool big_endian);
+void gfx_bgrx8888_to_rgb565(const uint8_t *src, uint16_t *dst, int16_t w, bool big_endian);
+void gfx_rgb565le_to_rgb565(const uint8_t *src, uint16_t *dst, int16_t w, bool big_endian);
+// palette already in the output byte order, bpp is 1, 2, 4 or 8 with the leftmost pixel in the high bits
+void gfx_indexed_to_rgb565(const uint8_t *src, uint16_t *dst, int16_t w, uint8_t bpp, const uint16_t *palette);
+
+/// Collects decoded image rows into multi-row strips and draws each strip with one draw16bitRGBBitmap() call
+class Arduino_ImageStrip
+{
+public:
+  Arduino_ImageStrip(Arduino_G *output, int16_t w, int16_t rows = GFX_IMAGE_STRIP_ROWS);
+  ~Arduino_ImageStrip();
+
+  bool begin();
+  void start(int16_t x, int16_t y, bool bottom_up = false);
+  uint16_t *nextRow();
+  void flush();
+
+  int16_t width();
+  int16_t rows();
+
+protected:
+  Arduino_G *_output;
+  int16_t _width, _rows;
+  uint16_t *_buffer = nullptr;
+  int16_t _x = 0, _y = 0;
+  bool _bottom_up = false;
+  int16_t _filled = 0;
+
+private:
+};
+
+#endif // _ARDUINO_IMAGESTRIP_H_
+
+#endif // !defined(LITTLE_FOOT_PRINT)
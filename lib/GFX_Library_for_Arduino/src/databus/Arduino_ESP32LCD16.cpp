@@ -479,37 +479,17 @@ void Arduino_ESP32LCD16::writeYCbCrPixels(uint8_t *yData, uint8_t *cbData, uint8
   {
     int cols = w >> 1;
     int rows = h >> 1;
-    uint8_t *yData2 = yData + w;
     uint16_t *dest = _buffer16;
-    uint16_t *dest2 = dest + w;
 
-    uint8_t pxCb, pxCr;
-    int16_t pxR, pxG, pxB, pxY;
-  
     uint16_t l = (w * 4) - 4;
     uint32_t out_dmadesc = ((l + 3) & (~3)) | l << 12 | 0xC0000000;
     bool poll_started = false;
     for (int row = 0; row < rows; ++row)
     {
-      for (int col = 0; col < cols; ++col)
-      {
-        pxCb = *cbData++;
-        pxCr = *crData++;
-        pxR = CR2R16[pxCr];
-        pxG = -CB2G16[pxCb] - CR2G16[pxCr];
-        pxB = CB2B16[pxCb];
-
-        pxY = Y2I16[*yData++];
-        *dest++ = CLIPR[pxY + pxR] | CLIPG[pxY + pxG] | CLIPB[pxY + pxB];
-        pxY = Y2I16[*yData++];
-        *dest++ = CLIPR[pxY + pxR] | CLIPG[pxY + pxG] | CLIPB[pxY + pxB];
-        pxY = Y2I16[*yData2++];
-        *dest2++ = CLIPR[pxY + pxR] | CLIPG[pxY + pxG] | CLIPB[pxY + pxB];
-        pxY = Y2I16[*yData2++];
-        *dest2++ = CLIPR[pxY + pxR] | CLIPG[pxY + pxG] | CLIPB[pxY + pxB];
-      }
-      yData += w;
-      yData2 += w;
+      gfx_ycbcr_to_rgb565(yData, cbData, crData, w, 2, true, dest, w, false);
+      yData += w * 2;
+      cbData += cols;
+      crData += cols;
 
       if (poll_started)
       {
@@ -546,8 +526,6 @@ void Arduino_ESP32LCD16::writeYCbCrPixels(uint8_t *yData, uint8_t *cbData, uint8
         __asm__ __volatile__("nop");
       }
       LCD_CAM.lcd_user.val = LCD_CAM_LCD_ALWAYS_OUT_EN | LCD_CAM_LCD_2BYTE_EN | LCD_CAM_LCD_CMD_2_CYCLE_EN | LCD_CAM_LCD_DOUT | LCD_CAM_LCD_CMD | LCD_CAM_LCD_UPDATE_REG | LCD_CAM_LCD_START;
-
-      dest2 = dest + w;
     }
 
     WAIT_LCD_NOT_BUSY;
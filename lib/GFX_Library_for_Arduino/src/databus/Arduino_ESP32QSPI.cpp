@@ -4,7 +4,8 @@
 
 Arduino_ESP32QSPI::Arduino_ESP32QSPI(
     int8_t cs, int8_t sck, int8_t mosi, int8_t miso, int8_t quadwp, int8_t quadhd, bool is_shared_interface /* = false */)
-    : _cs(cs), _sck(sck), _mosi(mosi), _miso(miso), _quadwp(quadwp), _quadhd(quadhd), _is_shared_interface(is_shared_interface)
+    : _cs(cs), _sck(sck), _mosi(mosi), _miso(miso), _quadwp(quadwp), _quadhd(quadhd), _is_shared_interface(is_shared_interface),
+      _queued(0), _queue_idx(0)
 {
 }
 
@@ -81,7 +82,7 @@ bool Arduino_ESP32QSPI::begin(int32_t speed, int8_t dataMode)
       .input_delay_ns = 0,
       .spics_io_num = -1, // avoid use system CS control
       .flags = SPI_DEVICE_HALFDUPLEX,
-      .queue_size = 1,
+      .queue_size = ESP32QSPI_QUEUE_SIZE,
       .pre_cb = nullptr,
       .post_cb = nullptr};
   esp_err_t ret = spi_bus_add_device(ESP32QSPI_SPI_HOST, &devcfg, &_handle);
@@ -110,6 +111,20 @@ bool Arduino_ESP32QSPI::begin(int32_t speed, int8_t dataMode)
     return false;
   }
 
+  // writePixels() never touches _buffer, other calls fill it before waiting for queued transfers
+  memset(_queue_tran, 0, sizeof(_queue_tran));
+  _queue_buffer32[0] = _2nd_buffer32;
+  for (uint8_t i = 1; i < ESP32QSPI_QUEUE_SIZE; ++i)
+  {
+    _queue_buffer32[i] = (uint32_t *)heap_caps_aligned_alloc(16, ESP32QSPI_MAX_PIXELS_AT_ONCE * 2, MALLOC_CAP_DMA);
+    if (!_queue_buffer32[i])
+    {
+      return false;
+    }
+  }
+  _queued = 0;
+  _queue_idx = 0;
+
   return true;
 }
 
@@ -125,6 +140,7 @@ void Arduino_ESP32QSPI::endWrite()
 {
   if (_is_shared_interface)
   {
+    waitIdle();
     spi_device_release_bus(_handle);
   }
 }
@@ -321,7 +337,12 @@ void Arduino_ESP32QSPI::writeRepeat(uint16_t p, uint32_t len)
 
 void Arduino_ESP32QSPI::writePixels(uint16_t *data, uint32_t len)
 {
+  writePixelsAsync(data, len);
+  waitIdle();
+}
 
+void Arduino_ESP32QSPI::writePixelsAsync(uint16_t *data, uint32_t len)
+{
   CS_LOW();
   uint32_t l, l2;
   uint16_t p1, p2;
@@ -330,40 +351,72 @@ void Arduino_ESP32QSPI::writePixels(uint16_t *data, uint32_t len)
   {
     l = (len > ESP32QSPI_MAX_PIXELS_AT_ONCE) ? ESP32QSPI_MAX_PIXELS_AT_ONCE : len;
 
+    if (_queued == ESP32QSPI_QUEUE_SIZE)
+    {
+      // transactions finish in order, the oldest one owns the slot about to be refilled
+      spi_transaction_t *done;
+      spi_device_get_trans_result(_handle, &done, portMAX_DELAY);
+      --_queued;
+    }
+    spi_transaction_ext_t *t = &_queue_tran[_queue_idx];
+    uint32_t *buf32 = _queue_buffer32[_queue_idx];
+    uint16_t *buf16 = (uint16_t *)buf32;
+
     if (first_send)
     {
-      _spi_tran_ext.base.flags = SPI_TRANS_MODE_QIO;
-      _spi_tran_ext.base.cmd = 0x32;
-      _spi_tran_ext.base.addr = 0x003C00;
+      t->base.flags = SPI_TRANS_MODE_QIO;
+      t->base.cmd = 0x32;
+      t->base.addr = 0x003C00;
       first_send = false;
     }
     else
     {
-      _spi_tran_ext.base.flags = SPI_TRANS_MODE_QIO | SPI_TRANS_VARIABLE_CMD |
-                                 SPI_TRANS_VARIABLE_ADDR | SPI_TRANS_VARIABLE_DUMMY;
+      t->base.flags = SPI_TRANS_MODE_QIO | SPI_TRANS_VARIABLE_CMD |
+                      SPI_TRANS_VARIABLE_ADDR | SPI_TRANS_VARIABLE_DUMMY;
     }
     l2 = l >> 1;
     for (uint32_t i = 0; i < l2; ++i)
     {
       p1 = *data++;
       p2 = *data++;
-      MSB_32_16_16_SET(_buffer32[i], p1, p2);
+      MSB_32_16_16_SET(buf32[i], p1, p2);
     }
     if (l & 1)
     {
       p1 = *data++;
-      MSB_16_SET(_buffer16[l - 1], p1);
+      MSB_16_SET(buf16[l - 1], p1);
     }
 
-    _spi_tran_ext.base.tx_buffer = _buffer32;
-    _spi_tran_ext.base.length = l << 4;
+    t->base.tx_buffer = buf32;
+    t->base.length = l << 4;
 
-    POLL_START();
-    POLL_END();
+    spi_device_queue_trans(_handle, (spi_transaction_t *)t, portMAX_DELAY);
+    ++_queued;
+    if (++_queue_idx == ESP32QSPI_QUEUE_SIZE)
+    {
+      _queue_idx = 0;
+    }
 
     len -= l;
   }
-  CS_HIGH();
+  if (!_queued)
+  {
+    CS_HIGH();
+  }
+}
+
+void Arduino_ESP32QSPI::waitIdle()
+{
+  if (_queued)
+  {
+    spi_transaction_t *done;
+    while (_queued)
+    {
+      spi_device_get_trans_result(_handle, &done, portMAX_DELAY);
+      --_queued;
+    }
+    CS_HIGH();
+  }
 }
 
 void Arduino_ESP32QSPI::batchOperation(const uint8_t *operations, size_t len)
@@ -610,37 +663,17 @@ void Arduino_ESP32QSPI::writeYCbCrPixels(uint8_t *yData, uint8_t *cbData, uint8_
 
     int cols = w >> 1;
     int rows = h >> 1;
-    uint8_t *yData2 = yData + w;
     uint16_t *dest = _buffer16;
-    uint16_t *dest2 = dest + w;
 
     uint16_t out_bits = w << 5;
 
-    uint8_t pxCb, pxCr;
-    int16_t pxR, pxG, pxB, pxY;
-
     CS_LOW();
     for (int row = 0; row < rows; ++row)
     {
-      for (int col = 0; col < cols; ++col)
-      {
-        pxCb = *cbData++;
-        pxCr = *crData++;
-        pxR = CR2R16[pxCr];
-        pxG = -CB2G16[pxCb] - CR2G16[pxCr];
-        pxB = CB2B16[pxCb];
-
-        pxY = Y2I16[*yData++];
-        *dest++ = CLIPRBE[pxY + pxR] | CLIPGBE[pxY + pxG] | CLIPBBE[pxY + pxB];
-        pxY = Y2I16[*yData++];
-        *dest++ = CLIPRBE[pxY + pxR] | CLIPGBE[pxY + pxG] | CLIPBBE[pxY + pxB];
-        pxY = Y2I16[*yData2++];
-        *dest2++ = CLIPRBE[pxY + pxR] | CLIPGBE[pxY + pxG] | CLIPBBE[pxY + pxB];
-        pxY = Y2I16[*yData2++];
-        *dest2++ = CLIPRBE[pxY + pxR] | CLIPGBE[pxY + pxG] | CLIPBBE[pxY + pxB];
-      }
-      yData += w;
-      yData2 += w;
+      gfx_ycbcr_to_rgb565(yData, cbData, crData, w, 2, true, dest, w, true);
+      yData += w * 2;
+      cbData += cols;
+      crData += cols;
 
       if (first_send)
       {
@@ -669,7 +702,6 @@ void Arduino_ESP32QSPI::writeYCbCrPixels(uint8_t *yData, uint8_t *cbData, uint8_
       _spi_tran_ext.base.length = out_bits;
 
       POLL_START();
-      dest2 = dest + w;
     }
     POLL_END();
     CS_HIGH();
@@ -684,6 +716,11 @@ GFX_INLINE void Arduino_ESP32QSPI::CS_HIGH(void)
 
 GFX_INLINE void Arduino_ESP32QSPI::CS_LOW(void)
 {
+  if (_queued)
+  {
+    // end the pixel stream writePixelsAsync() left running, polling transfers cannot start before it
+    waitIdle();
+  }
   *_csPortClr = _csPinMask;
 }
 
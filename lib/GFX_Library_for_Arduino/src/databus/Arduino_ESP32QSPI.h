@@ -20,6 +20,13 @@
 #ifndef ESP32QSPI_DMA_CHANNEL
 #define ESP32QSPI_DMA_CHANNEL SPI_DMA_CH_AUTO
 #endif
+// Pixel chunks writePixels() keeps in flight, byte swapping the next chunk while the previous ones are sent
+#ifndef ESP32QSPI_QUEUE_SIZE
+#define ESP32QSPI_QUEUE_SIZE 2
+#endif
+#if (ESP32QSPI_QUEUE_SIZE < 2)
+#error "ESP32QSPI_QUEUE_SIZE must be at least 2"
+#endif
 
 class Arduino_ESP32QSPI : public Arduino_DataBus
 {
@@ -45,6 +52,8 @@ public:
 
   void writeRepeat(uint16_t p, uint32_t len) override;
   void writePixels(uint16_t *data, uint32_t len) override;
+  void writePixelsAsync(uint16_t *data, uint32_t len) override;
+  void waitIdle() override;
   void write16bitBeRGBBitmapR1(uint16_t *bitmap, int16_t w, int16_t h) override;
 
   void batchOperation(const uint8_t *operations, size_t len) override;
@@ -72,6 +81,11 @@ private:
   spi_transaction_ext_t _spi_tran_ext;
   spi_transaction_t *_spi_tran;
 
+  spi_transaction_ext_t _queue_tran[ESP32QSPI_QUEUE_SIZE];
+  uint32_t *_queue_buffer32[ESP32QSPI_QUEUE_SIZE]; // [0] is _2nd_buffer
+  uint8_t _queued;    // transactions queued and not yet collected
+  uint8_t _queue_idx; // next slot to fill
+
   union
   {
     uint8_t *_buffer;
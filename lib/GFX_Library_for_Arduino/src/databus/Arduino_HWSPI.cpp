@@ -4,6 +4,10 @@
  */
 #include "Arduino_HWSPI.h"
 
+#if defined(ESP32) && !defined(LITTLE_FOOT_PRINT)
+#include <esp_heap_caps.h>
+#endif
+
 #if defined(SPI_HAS_TRANSACTION)
 #define SPI_BEGIN_TRANSACTION() _spi->beginTransaction(mySPISettings)
 #define SPI_END_TRANSACTION() _spi->endTransaction()
@@ -32,6 +36,10 @@ Arduino_HWSPI::Arduino_HWSPI(int8_t dc, int8_t cs /* = GFX_NOT_DEFINED */, SPICl
     : _dc(dc), _cs(cs), _spi(spi), _is_shared_interface(is_shared_interface)
 {
 #endif
+#if !defined(LITTLE_FOOT_PRINT)
+  _buffer.v8 = nullptr;
+  _buffer_pixels = 0;
+#endif // !defined(LITTLE_FOOT_PRINT)
 }
 
 bool Arduino_HWSPI::begin(int32_t speed, int8_t dataMode)
@@ -210,9 +218,61 @@ bool Arduino_HWSPI::begin(int32_t speed, int8_t dataMode)
   }
 #endif
 
+#if !defined(LITTLE_FOOT_PRINT)
+  if ((!_buffer.v8) && (!setBufferSize(SPI_MAX_PIXELS_AT_ONCE)))
+  {
+    return false;
+  }
+#endif // !defined(LITTLE_FOOT_PRINT)
+
   return true;
 }
 
+#if !defined(LITTLE_FOOT_PRINT)
+/**
+ * @brief setBufferSize
+ *
+ * Resize the pixel staging buffer used by writeRepeat() and writePixels().
+ * Larger buffers mean fewer and longer bus transfers. On ESP32 the buffer
+ * is allocated from DMA capable internal RAM, and writePixels() only uses it
+ * for sources that are not word aligned.
+ * Can be called before or after begin(), but not inside a write transaction.
+ *
+ * @param pixels buffer size in 16-bit pixels
+ * @return true on success, false keeps the previous buffer
+ */
+bool Arduino_HWSPI::setBufferSize(uint32_t pixels)
+{
+  if (pixels == 0)
+  {
+    return false;
+  }
+  if (pixels == _buffer_pixels)
+  {
+    return true;
+  }
+
+#if defined(ESP32)
+  uint8_t *buf = (uint8_t *)heap_caps_malloc(pixels * 2, MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+#else
+  uint8_t *buf = (uint8_t *)malloc(pixels * 2);
+#endif
+  if (!buf)
+  {
+    return false;
+  }
+
+  if (_buffer.v8)
+  {
+    free(_buffer.v8);
+  }
+  _buffer.v8 = buf;
+  _buffer_pixels = pixels;
+
+  return true;
+}
+#endif // !defined(LITTLE_FOOT_PRINT)
+
 void Arduino_HWSPI::beginWrite()
 {
   if (_is_shared_interface)
@@ -295,9 +355,10 @@ void Arduino_HWSPI::writeRepeat(uint16_t p, uint32_t len)
     WRITE(_data16.msb);
     WRITE(_data16.lsb);
   }
-#elif defined(ESP8266) || defined(CONFIG_ARCH_CHIP_CXD56XX)
+#elif defined(ESP8266) || defined(ESP32) || defined(CONFIG_ARCH_CHIP_CXD56XX)
+  // these cores only transmit, the buffer is filled once and sent as is
   MSB_16_SET(p, p);
-  uint32_t xferLen = (len < SPI_MAX_PIXELS_AT_ONCE) ? len : SPI_MAX_PIXELS_AT_ONCE;
+  uint32_t xferLen = (len < _buffer_pixels) ? len : _buffer_pixels;
   for (uint32_t i = 0; i < xferLen; i++)
   {
     _buffer.v16[i] = p;
@@ -305,19 +366,20 @@ void Arduino_HWSPI::writeRepeat(uint16_t p, uint32_t len)
 
   while (len)
   {
-    xferLen = (len < SPI_MAX_PIXELS_AT_ONCE) ? len : SPI_MAX_PIXELS_AT_ONCE;
+    xferLen = (len < _buffer_pixels) ? len : _buffer_pixels;
     len -= xferLen;
 
     xferLen += xferLen;
     WRITEBUF(_buffer.v8, xferLen);
   }
 #else  // other arch
+  // transfer() overwrites the buffer with received data, refill every chunk
   MSB_16_SET(p, p);
   uint32_t xferLen;
 
   while (len)
   {
-    xferLen = (len < SPI_MAX_PIXELS_AT_ONCE) ? len : SPI_MAX_PIXELS_AT_ONCE;
+    xferLen = (len < _buffer_pixels) ? len : _buffer_pixels;
     for (uint32_t i = 0; i < xferLen; i++)
     {
       _buffer.v16[i] = p;
@@ -352,6 +414,14 @@ void Arduino_HWSPI::writePixels(uint16_t *data, uint32_t len)
     WRITE(_data16.lsb);
   }
 #else  // !defined(LITTLE_FOOT_PRINT)
+#if defined(ESP32)
+  if (((uintptr_t)data & 3) == 0)
+  {
+    // the core swaps word aligned pixels on the way into the SPI FIFO, no staging copy
+    _spi->writePixels(data, len << 1);
+    return;
+  }
+#endif // defined(ESP32)
   uint32_t xferLen;
   uint8_t *b;
   union
@@ -365,7 +435,7 @@ void Arduino_HWSPI::writePixels(uint16_t *data, uint32_t len)
   } t;
   while (len)
   {
-    xferLen = (len < SPI_MAX_PIXELS_AT_ONCE) ? len : SPI_MAX_PIXELS_AT_ONCE;
+    xferLen = (len < _buffer_pixels) ? len : _buffer_pixels;
     b = _buffer.v8;
     for (uint32_t i = 0; i < xferLen; i++)
     {
@@ -43,6 +43,9 @@ public:
 
 #if !defined(LITTLE_FOOT_PRINT)
   void writePattern(uint8_t *data, uint8_t len, uint32_t repeat) override;
+
+  bool setBufferSize(uint32_t pixels);
+  uint32_t getBufferSize() { return _buffer_pixels; }
 #endif // !defined(LITTLE_FOOT_PRINT)
 
 private:
@@ -95,9 +98,10 @@ private:
 #if !defined(LITTLE_FOOT_PRINT)
   union
   {
-    uint8_t v8[SPI_MAX_PIXELS_AT_ONCE * 2] = {0};
-    uint16_t v16[SPI_MAX_PIXELS_AT_ONCE];
+    uint8_t *v8;
+    uint16_t *v16;
   } _buffer;
+  uint32_t _buffer_pixels;
 #endif // !defined(LITTLE_FOOT_PRINT)
 };
 
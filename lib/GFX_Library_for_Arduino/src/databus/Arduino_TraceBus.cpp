@@ -0,0 +1,148 @@
+#include "Arduino_TraceBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+Arduino_TraceBus::Arduino_TraceBus(Print *trace /* = nullptr */)
+    : _trace(trace)
+{
+  resetStats();
+}
+
+bool Arduino_TraceBus::begin(int32_t speed, int8_t dataMode)
+{
+  _speed = speed;
+  _dataMode = dataMode;
+
+  return true;
+}
+
+void Arduino_TraceBus::beginWrite()
+{
+  ++_stats.transactions;
+  traceLine("begin", -1, -1);
+}
+
+void Arduino_TraceBus::endWrite()
+{
+  traceLine("end", -1, -1);
+}
+
+void Arduino_TraceBus::writeCommand(uint8_t c)
+{
+  ++_stats.commands;
+  ++_stats.command_bytes;
+  traceLine("cmd", c, -1);
+}
+
+void Arduino_TraceBus::writeCommand16(uint16_t c)
+{
+  ++_stats.commands;
+  _stats.command_bytes += 2;
+  traceLine("cmd16", c, -1);
+}
+
+void Arduino_TraceBus::writeCommandBytes(uint8_t *data, uint32_t len)
+{
+  // each byte is an 8-bit command, as if sent with writeCommand()
+  _stats.commands += len;
+  _stats.command_bytes += len;
+  traceLine("cmdbytes", -1, len);
+}
+
+void Arduino_TraceBus::write(uint8_t d)
+{
+  ++_stats.data_bytes;
+  traceLine("data", d, -1);
+}
+
+void Arduino_TraceBus::write16(uint16_t d)
+{
+  _stats.data_bytes += 2;
+  traceLine("data16", d, -1);
+}
+
+void Arduino_TraceBus::writeC8D16D16(uint8_t c, uint16_t d1, uint16_t d2)
+{
+  ++_stats.commands;
+  ++_stats.addr_windows;
+  ++_stats.command_bytes;
+  _stats.data_bytes += 4;
+  if (_trace)
+  {
+    _trace->print("window ");
+    _trace->print(c, HEX);
+    _trace->print(' ');
+    _trace->print(d1);
+    _trace->print(' ');
+    _trace->println(d2);
+  }
+}
+
+void Arduino_TraceBus::writeC8D16D16Split(uint8_t c, uint16_t d1, uint16_t d2)
+{
+  writeC8D16D16(c, d1, d2);
+}
+
+void Arduino_TraceBus::writeRepeat(uint16_t p, uint32_t len)
+{
+  ++_stats.repeat_calls;
+  _stats.data_bytes += len * 2;
+  traceLine("repeat", p, len);
+}
+
+void Arduino_TraceBus::writeBytes(uint8_t *data, uint32_t len)
+{
+  ++_stats.bytes_calls;
+  _stats.data_bytes += len;
+  traceLine("bytes", -1, len);
+}
+
+void Arduino_TraceBus::writePixels(uint16_t *data, uint32_t len)
+{
+  ++_stats.pixel_calls;
+  _stats.data_bytes += len * 2;
+  traceLine("pixels", -1, len);
+}
+
+void Arduino_TraceBus::batchOperation(const uint8_t *operations, size_t len)
+{
+  ++_stats.batches;
+  traceLine("batch", -1, len);
+  Arduino_DataBus::batchOperation(operations, len);
+}
+
+const gfx_bus_stats_t *Arduino_TraceBus::getStats()
+{
+  return &_stats;
+}
+
+void Arduino_TraceBus::resetStats()
+{
+  memset(&_stats, 0, sizeof(_stats));
+}
+
+void Arduino_TraceBus::setTrace(Print *trace)
+{
+  _trace = trace;
+}
+
+// one line per call: name, then the command or color in hex and the length in decimal when given
+void Arduino_TraceBus::traceLine(const char *name, int32_t value, int32_t count)
+{
+  if (_trace)
+  {
+    _trace->print(name);
+    if (value >= 0)
+    {
+      _trace->print(' ');
+      _trace->print((uint32_t)value, HEX);
+    }
+    if (count >= 0)
+    {
+      _trace->print(' ');
+      _trace->print(count);
+    }
+    _trace->println();
+  }
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -0,0 +1,59 @@
+// Databus stand-in that sends nothing and counts the traffic a display driver generates.
+// Needs no hardware, so drivers can be measured for bytes on wire and transactions per
+// primitive anywhere the library compiles, including host builds with stubbed Arduino headers.
+
+#include "Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef _ARDUINO_TRACEBUS_H_
+#define _ARDUINO_TRACEBUS_H_
+
+typedef struct
+{
+  uint32_t transactions;  ///< beginWrite() calls
+  uint32_t commands;      ///< 8 and 16-bit commands, one per writeCommandBytes() byte
+  uint32_t addr_windows;  ///< writeC8D16D16() and writeC8D16D16Split() calls
+  uint32_t batches;       ///< batchOperation() calls
+  uint32_t repeat_calls;  ///< writeRepeat() calls
+  uint32_t pixel_calls;   ///< writePixels() calls
+  uint32_t bytes_calls;   ///< writeBytes() calls
+  uint32_t command_bytes; ///< bytes sent with DC low
+  uint32_t data_bytes;    ///< bytes sent with DC high
+} gfx_bus_stats_t;
+
+class Arduino_TraceBus : public Arduino_DataBus
+{
+public:
+  Arduino_TraceBus(Print *trace = nullptr); // Constructor
+
+  bool begin(int32_t speed = GFX_NOT_DEFINED, int8_t dataMode = GFX_NOT_DEFINED) override;
+  void beginWrite() override;
+  void endWrite() override;
+  void writeCommand(uint8_t) override;
+  void writeCommand16(uint16_t) override;
+  void writeCommandBytes(uint8_t *data, uint32_t len) override;
+  void write(uint8_t) override;
+  void write16(uint16_t) override;
+  void writeC8D16D16(uint8_t c, uint16_t d1, uint16_t d2) override;
+  void writeC8D16D16Split(uint8_t c, uint16_t d1, uint16_t d2) override;
+  void writeRepeat(uint16_t p, uint32_t len) override;
+  void writeBytes(uint8_t *data, uint32_t len) override;
+  void writePixels(uint16_t *data, uint32_t len) override;
+  void batchOperation(const uint8_t *operations, size_t len) override;
+
+  const gfx_bus_stats_t *getStats();
+  void resetStats();
+  void setTrace(Print *trace);
+
+protected:
+  void traceLine(const char *name, int32_t value, int32_t count);
+
+  gfx_bus_stats_t _stats;
+  Print *_trace;
+
+private:
+};
+
+#endif // _ARDUINO_TRACEBUS_H_
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -245,6 +245,102 @@ void Arduino_RGB_Display::writeFastHLineCore(int16_t x, int16_t y,
   }
 }
 
+void Arduino_RGB_Display::writeHLineSpans(const int16_t *spans, uint16_t count, uint16_t color)
+{
+  // log_i("writeHLineSpans(count: %d)", count);
+  // fill every span first, then write back the framebuffer area touched in one go
+  bool auto_flush = _auto_flush;
+  _auto_flush = false;
+  int32_t col_min = INT32_MAX;
+  int32_t col_max = INT32_MIN;
+  int32_t row_min = INT32_MAX;
+  int32_t row_max = INT32_MIN;
+  int32_t c1, c2, r1, r2;
+  const int16_t *end = spans + (count * 3);
+  for (; spans < end; spans += 3)
+  {
+    switch (_rotation)
+    {
+    case 1:
+      writeFastVLineCore(_max_y - spans[1], spans[0], spans[2], color);
+      c1 = c2 = _max_y - spans[1];
+      r1 = spans[0];
+      r2 = spans[0] + spans[2] - 1;
+      break;
+    case 2:
+      writeFastHLineCore(_width - spans[0] - spans[2], _max_y - spans[1], spans[2], color);
+      c1 = _width - spans[0] - spans[2];
+      c2 = _width - spans[0] - 1;
+      r1 = r2 = _max_y - spans[1];
+      break;
+    case 3:
+      writeFastVLineCore(spans[1], _width - spans[0] - spans[2], spans[2], color);
+      c1 = c2 = spans[1];
+      r1 = _width - spans[0] - spans[2];
+      r2 = _width - spans[0] - 1;
+      break;
+    default: // case 0:
+      writeFastHLineCore(spans[0], spans[1], spans[2], color);
+      c1 = spans[0];
+      c2 = spans[0] + spans[2] - 1;
+      r1 = r2 = spans[1];
+    }
+    if (c1 > c2) // negative width
+    {
+      int32_t t = c1;
+      c1 = c2;
+      c2 = t;
+    }
+    if (r1 > r2)
+    {
+      int32_t t = r1;
+      r1 = r2;
+      r2 = t;
+    }
+    if (c1 < col_min)
+    {
+      col_min = c1;
+    }
+    if (c2 > col_max)
+    {
+      col_max = c2;
+    }
+    if (r1 < row_min)
+    {
+      row_min = r1;
+    }
+    if (r2 > row_max)
+    {
+      row_max = r2;
+    }
+  }
+  _auto_flush = auto_flush;
+
+  if (_auto_flush)
+  {
+    if (col_min < 0)
+    {
+      col_min = 0;
+    }
+    if (col_max > MAX_X)
+    {
+      col_max = MAX_X;
+    }
+    if (row_min < 0)
+    {
+      row_min = 0;
+    }
+    if (row_max > MAX_Y)
+    {
+      row_max = MAX_Y;
+    }
+    if ((col_min <= col_max) && (row_min <= row_max))
+    {
+      cacheWriteBackRect(col_min + COL_OFFSET1, row_min + ROW_OFFSET1, col_max - col_min + 1, row_max - row_min + 1);
+    }
+  }
+}
+
 void Arduino_RGB_Display::writeFillRectPreclipped(int16_t x, int16_t y,
                                                   int16_t w, int16_t h, uint16_t color)
 {
@@ -402,27 +498,38 @@ void Arduino_RGB_Display::draw16bitRGBBitmap(int16_t x, int16_t y,
   {
     if (_auto_flush)
     {
-      uint32_t cachePos;
-      size_t cache_size;
-      switch (_rotation)
+      if (_rotation > 0)
+      {
+        // clip the same way the rotated copy did, then write back only what it touched
+        int16_t max_x = ((_rotation == 2) ? _fb_width : _fb_height) - 1;
+        int16_t max_y = ((_rotation == 2) ? _fb_height : _fb_width) - 1;
+        int16_t x1 = ((x + w - 1) > max_x) ? max_x : (x + w - 1);
+        int16_t y1 = ((y + h - 1) > max_y) ? max_y : (y + h - 1);
+        if (x < 0)
+        {
+          x = 0;
+        }
+        if (y < 0)
+        {
+          y = 0;
+        }
+        switch (_rotation)
+        {
+        case 1:
+          cacheWriteBackRect(_fb_width - 1 - y1, x, y1 - y + 1, x1 - x + 1);
+          break;
+        case 2:
+          cacheWriteBackRect(_fb_width - 1 - x1, _fb_height - 1 - y1, x1 - x + 1, y1 - y + 1);
+          break;
+        case 3:
+          cacheWriteBackRect(y, _fb_height - 1 - x1, y1 - y + 1, x1 - x + 1);
+          break;
+        }
+      }
+      else
       {
-      case 1:
-        cachePos = (uint32_t)(_framebuffer + (x * _fb_width));
-        cache_size = _fb_width * w * 2;
-        break;
-      case 2:
-        cachePos = (uint32_t)(_framebuffer + ((HEIGHT - y - h) * _fb_width));
-        cache_size = _fb_width * h * 2;
-        break;
-      case 3:
-        cachePos = (uint32_t)(_framebuffer + ((HEIGHT - x - w) * _fb_width));
-        cache_size = _fb_width * w * 2;
-        break;
-      default: // case 0:
-        cachePos = (uint32_t)(_framebuffer + (y * _fb_width) + x);
-        cache_size = (_fb_width * (h - 1) + w) * 2;
+        Cache_WriteBack_Addr((uint32_t)(_framebuffer + (y * _fb_width) + x), (_fb_width * (h - 1) + w) * 2);
       }
-      Cache_WriteBack_Addr(cachePos, cache_size);
     }
   }
 }
@@ -508,41 +615,8 @@ void Arduino_RGB_Display::drawYCbCrBitmap(int16_t x, int16_t y, uint8_t *yData,
   }
   else
   {
-    int rows = h >> 1;
-
-    uint16_t *dest = _framebuffer;
-    dest += y * _fb_width;
-    uint16_t *cachePos = dest;
-    dest += x;
-    uint16_t *dest2 = dest + _fb_width;
-    uint8_t *yData2 = yData + w;
-
-    uint8_t pxCb, pxCr;
-    int16_t pxR, pxG, pxB, pxY;
-
-    for (int row = 0; row < rows; ++row)
-    {
-      for (int col = 0; col < w;)
-      {
-        pxCb = *cbData++;
-        pxCr = *crData++;
-        pxR = CR2R16[pxCr];
-        pxG = -CB2G16[pxCb] - CR2G16[pxCr];
-        pxB = CB2B16[pxCb];
-        pxY = Y2I16[*yData++];
-        dest[col] = CLIPR[pxY + pxR] | CLIPG[pxY + pxG] | CLIPB[pxY + pxB];
-        pxY = Y2I16[*yData2++];
-        dest2[col++] = CLIPR[pxY + pxR] | CLIPG[pxY + pxG] | CLIPB[pxY + pxB];
-        pxY = Y2I16[*yData++];
-        dest[col] = CLIPR[pxY + pxR] | CLIPG[pxY + pxG] | CLIPB[pxY + pxB];
-        pxY = Y2I16[*yData2++];
-        dest2[col++] = CLIPR[pxY + pxR] | CLIPG[pxY + pxG] | CLIPB[pxY + pxB];
-      }
-      yData += w;
-      yData2 += w;
-      dest = dest2 + _fb_width;
-      dest2 = dest + _fb_width;
-    }
+    uint16_t *cachePos = _framebuffer + (y * _fb_width);
+    gfx_ycbcr_to_rgb565(yData, cbData, crData, w, h, true, cachePos + x, _fb_width, false);
     if (_auto_flush)
     {
       Cache_WriteBack_Addr((uint32_t)cachePos, _fb_width * h * 2);
@@ -550,6 +624,46 @@ void Arduino_RGB_Display::drawYCbCrBitmap(int16_t x, int16_t y, uint8_t *yData,
   }
 }
 
+bool Arduino_RGB_Display::copyRect(int16_t src_x, int16_t src_y, int16_t dst_x, int16_t dst_y, int16_t w, int16_t h)
+{
+  if (!_framebuffer)
+  {
+    return false;
+  }
+  if (!copyRectMap(src_x, src_y, dst_x, dst_y, w, h))
+  {
+    return true;
+  }
+  src_x += COL_OFFSET1;
+  src_y += ROW_OFFSET1;
+  dst_x += COL_OFFSET1;
+  dst_y += ROW_OFFSET1;
+  gfx_copy_rect16(_framebuffer, _fb_width, src_x, src_y, dst_x, dst_y, w, h);
+  if (_auto_flush)
+  {
+    cacheWriteBackRect(dst_x, dst_y, w, h);
+  }
+  return true;
+}
+
+void Arduino_RGB_Display::cacheWriteBackRect(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  uint16_t *p = _framebuffer + ((int32_t)y * _fb_width) + x;
+  if ((w * 4) < _fb_width)
+  {
+    // narrow band, e.g. a rotated blit: skip the untouched rest of each row
+    while (h--)
+    {
+      Cache_WriteBack_Addr((uint32_t)p, w * 2);
+      p += _fb_width;
+    }
+  }
+  else
+  {
+    Cache_WriteBack_Addr((uint32_t)p, ((_fb_width * (h - 1)) + w) * 2);
+  }
+}
+
 void Arduino_RGB_Display::flush(bool force_flush)
 {
   if (force_flush || (!_auto_flush))
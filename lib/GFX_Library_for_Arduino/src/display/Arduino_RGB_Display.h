@@ -2468,16 +2468,19 @@ public:
     void writeFastVLineCore(int16_t x, int16_t y, int16_t h, uint16_t color);
     void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
     void writeFastHLineCore(int16_t x, int16_t y, int16_t w, uint16_t color);
+    void writeHLineSpans(const int16_t *spans, uint16_t count, uint16_t color) override;
     void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
     void drawIndexedBitmap(int16_t x, int16_t y, uint8_t *bitmap, uint16_t *color_index, int16_t w, int16_t h, int16_t x_skip = 0) override;
     void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
     void draw16bitBeRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
+    bool copyRect(int16_t src_x, int16_t src_y, int16_t dst_x, int16_t dst_y, int16_t w, int16_t h) override;
     void flush(bool force_flush = false) override;
 
     void drawYCbCrBitmap(int16_t x, int16_t y, uint8_t *yData, uint8_t *cbData, uint8_t *crData, int16_t w, int16_t h);
     uint16_t *getFramebuffer();
 
 protected:
+    void cacheWriteBackRect(int16_t x, int16_t y, int16_t w, int16_t h);
     uint16_t *_framebuffer;
     size_t _framebuffer_size;
     Arduino_ESP32RGBPanel *_rgbpanel;
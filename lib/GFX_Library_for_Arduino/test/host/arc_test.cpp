@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * fillArc() / drawArc() host check and benchmark
+ * Built twice by the Makefile, with GFX_FAST_ARC 1 (row spans) and 0 (the per
+ * pixel loop):
+ *   arc_test dump   one line per outer radius with the number of cases and a
+ *                   hash of the pixels they cover; both builds must print
+ *                   the same lines (make arc_compare)
+ *   arc_test bench  time for a set of gauge style arcs (make arc_bench)
+ ******************************************************************************/
+#include "Arduino_GFX.h"
+#include <vector>
+
+#define ARC_W 800
+#define ARC_H 480
+
+// Records the spans the helpers write; nothing is drawn
+class SpanGFX : public Arduino_GFX
+{
+public:
+  struct Span
+  {
+    int16_t y, x, w;
+  };
+  std::vector<Span> spans;
+
+  SpanGFX() : Arduino_GFX(ARC_W, ARC_H) {}
+  bool begin(int32_t) override { return true; }
+  void writePixelPreclipped(int16_t x, int16_t y, uint16_t) override { spans.push_back({y, x, 1}); }
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t) override { spans.push_back({y, x, w}); }
+  void drawBitmap(int16_t, int16_t, uint8_t *, int16_t, int16_t, uint16_t, uint16_t) override {}
+
+  // Hash of the covered pixels, independent of how they were split into spans or ordered
+  uint64_t coverageHash()
+  {
+    std::sort(spans.begin(), spans.end(), [](const Span &a, const Span &b)
+              { return a.y != b.y ? a.y < b.y : a.x < b.x; });
+    uint64_t h = 1469598103934665603ULL;
+    size_t i = 0;
+    while (i < spans.size())
+    {
+      int16_t y = spans[i].y, x0 = spans[i].x;
+      int32_t x1 = x0 + spans[i].w;
+      for (++i; i < spans.size() && spans[i].y == y && spans[i].x <= x1; ++i)
+      {
+        x1 = max(x1, (int32_t)(spans[i].x + spans[i].w));
+      }
+      uint64_t v = ((uint64_t)(uint16_t)y << 32) | ((uint64_t)(uint16_t)x0 << 16) | (uint16_t)(x1 - x0);
+      h = (h ^ v) * 1099511628211ULL;
+    }
+    spans.clear();
+    return h;
+  }
+};
+
+static int dump()
+{
+  SpanGFX g;
+  for (int16_t r1 = 1; r1 <= 60; r1++)
+  {
+    uint64_t h = 1469598103934665603ULL;
+    uint32_t cases = 0;
+    int16_t rstep = (r1 > 20) ? 5 : 1;
+    float astep = (r1 > 20) ? 12.5f : 5.5f;
+    float bstep = (r1 > 20) ? 17.0f : 7.5f;
+    for (int16_t r2 = 0; r2 <= r1; r2 += rstep)
+    {
+      for (float a = -30; a <= 400; a += astep)
+      {
+        for (float b = -30; b <= 400; b += bstep)
+        {
+          g.fillArc(100, 100, r1, r2, a, b, 1);
+          h = (h ^ g.coverageHash()) * 1099511628211ULL;
+          g.drawArc(100, 100, r1, r2, a, b, 1);
+          h = (h ^ g.coverageHash()) * 1099511628211ULL;
+          cases += 2;
+        }
+      }
+    }
+    printf("r1 %2d cases %6u hash %016llx\n", r1, cases, (unsigned long long)h);
+  }
+  return 0;
+}
+
+static int bench()
+{
+  SpanGFX g;
+  g.spans.reserve(1 << 16);
+  unsigned long best = ~0UL;
+  for (int round = 0; round < 5; round++)
+  {
+    unsigned long t = micros();
+    for (int k = 0; k < 20; k++)
+    {
+      for (int16_t r = 20; r < 200; r += 4)
+      {
+        g.fillArc(400, 240, r, r - r / 4, 30, 30 + r * 1.5f, 1); // thick gauge ring
+        g.fillArc(400, 240, r, r - 3, 0, r * 1.8f, 1);           // thin outline
+        g.spans.clear();
+      }
+    }
+    best = min(best, micros() - t);
+  }
+  printf("GFX_FAST_ARC %d: %lu us\n", GFX_FAST_ARC, best);
+  return 0;
+}
+
+int main(int argc, char **argv)
+{
+  if (argc > 1 && strcmp(argv[1], "bench") == 0)
+  {
+    return bench();
+  }
+  return dump();
+}
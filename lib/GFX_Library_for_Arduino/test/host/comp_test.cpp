@@ -0,0 +1,243 @@
+/*******************************************************************************
+ * Arduino_Compositor host check
+ *   - gfx_blend565() against a per channel reference, every alpha 0 - 32
+ *   - an A8 ramp 0 - 255 composes to the same per channel reference
+ *   - random layer moves, opacity and visibility changes and pixel edits,
+ *     flushed through the dirty rectangles, leave the output identical to a
+ *     full recompose of the same layers
+ ******************************************************************************/
+#include "Arduino_GFX.h"
+#include "canvas/Arduino_Compositor.h"
+
+#define COMP_W 256
+#define COMP_H 160
+
+// Output that keeps what the compositor draws
+class FrameG : public Arduino_G
+{
+public:
+  uint16_t fb[COMP_H][COMP_W];
+
+  FrameG() : Arduino_G(COMP_W, COMP_H) { memset(fb, 0, sizeof(fb)); }
+  bool begin(int32_t) override { return true; }
+  void drawBitmap(int16_t, int16_t, uint8_t *, int16_t, int16_t, uint16_t, uint16_t) override {}
+  void drawIndexedBitmap(int16_t, int16_t, uint8_t *, uint16_t *, int16_t, int16_t, int16_t) override {}
+  void draw3bitRGBBitmap(int16_t, int16_t, uint8_t *, int16_t, int16_t) override {}
+  void draw24bitRGBBitmap(int16_t, int16_t, uint8_t *, int16_t, int16_t) override {}
+  void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override
+  {
+    for (int16_t j = 0; j < h; j++)
+    {
+      memcpy(&fb[y + j][x], bitmap + (j * w), w * 2);
+    }
+  }
+};
+
+static uint32_t seed = 1;
+
+static int32_t rnd(int32_t lo, int32_t hi)
+{
+  seed = seed * 1103515245 + 12345;
+  return lo + (int32_t)((seed >> 8) % (uint32_t)(hi - lo + 1));
+}
+
+// bg + (fg - bg) * alpha / 32 on each channel, rounded down
+static uint16_t ref_blend565(uint16_t fg, uint16_t bg, uint8_t alpha32)
+{
+  static const uint16_t masks[] = {0xF800, 0x07E0, 0x001F};
+  uint16_t out = 0;
+  for (uint16_t m : masks)
+  {
+    int shift = __builtin_ctz(m);
+    int32_t f = (fg & m) >> shift;
+    int32_t b = (bg & m) >> shift;
+    int32_t c = b + (((f - b) * alpha32) >> 5);
+    out |= (uint16_t)(c << shift);
+  }
+  return out;
+}
+
+static int check_blend()
+{
+  for (uint8_t a = 0; a <= 32; a++)
+  {
+    // every pair of channel values, all three channels at once
+    for (uint16_t f = 0; f < 64; f++)
+    {
+      for (uint16_t b = 0; b < 64; b++)
+      {
+        uint16_t fg = ((f >> 1) << 11) | (f << 5) | (63 - f) >> 1;
+        uint16_t bg = ((b >> 1) << 11) | (b << 5) | (63 - b) >> 1;
+        if (gfx_blend565(fg, bg, a) != ref_blend565(fg, bg, a))
+        {
+          printf("comp_test: FAIL gfx_blend565(%04x, %04x, %u) = %04x, expected %04x\n",
+                 fg, bg, a, gfx_blend565(fg, bg, a), ref_blend565(fg, bg, a));
+          return 1;
+        }
+      }
+    }
+    // and every foreground against random backgrounds
+    for (uint32_t fg = 0; fg < 0x10000; fg++)
+    {
+      for (int k = 0; k < 16; k++)
+      {
+        uint16_t bg = rnd(0, 0xFFFF);
+        if (gfx_blend565(fg, bg, a) != ref_blend565(fg, bg, a))
+        {
+          printf("comp_test: FAIL gfx_blend565(%04x, %04x, %u) = %04x, expected %04x\n",
+                 fg, bg, a, gfx_blend565(fg, bg, a), ref_blend565(fg, bg, a));
+          return 1;
+        }
+      }
+    }
+  }
+  return 0;
+}
+
+// one row with alpha 0 - 255 over the background, at full and half layer opacity
+static int check_alpha_ramp()
+{
+  static uint16_t pixels[256];
+  static uint8_t alpha[256];
+  for (int i = 0; i < 256; i++)
+  {
+    pixels[i] = (uint16_t)rnd(0, 0xFFFF);
+    alpha[i] = i;
+  }
+  const uint16_t bg = 0x8410;
+  for (uint8_t opacity : {(uint8_t)255, (uint8_t)128})
+  {
+    FrameG out;
+    Arduino_Compositor comp(256, 1, &out);
+    comp.begin();
+    comp.setBackground(bg);
+    int8_t layer = comp.addLayer(pixels, alpha, 256, 1);
+    comp.setLayerOpacity(layer, opacity);
+    comp.flush();
+    for (int i = 0; i < 256; i++)
+    {
+      uint16_t a8 = (opacity == 255) ? i : (((i * opacity) + 255) >> 8);
+      uint16_t expect = (a8 == 255) ? pixels[i] : ref_blend565(pixels[i], bg, (a8 + 4) >> 3);
+      if (out.fb[0][i] != expect)
+      {
+        printf("comp_test: FAIL alpha %d opacity %u: %04x, expected %04x\n", i, opacity, out.fb[0][i], expect);
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+static void randomize(uint16_t *pixels, uint8_t *alpha, int32_t len)
+{
+  for (int32_t i = 0; i < len; i++)
+  {
+    pixels[i] = (uint16_t)rnd(0, 0xFFFF);
+    if (alpha)
+    {
+      int32_t a = rnd(-64, 320); // plenty of fully clear and fully opaque pixels
+      alpha[i] = (a < 0) ? 0 : ((a > 255) ? 255 : a);
+    }
+  }
+}
+
+static int check_dirty_rects(uint32_t *steps)
+{
+  struct
+  {
+    int16_t w, h;
+    bool has_alpha;
+  } specs[] = {{COMP_W, COMP_H, false}, {60, 40, true}, {90, 30, false}, {24, 24, true}, {40, 70, true}};
+  const int layers = sizeof(specs) / sizeof(specs[0]);
+  uint16_t *pixels[layers];
+  uint8_t *alpha[layers];
+
+  FrameG out;
+  Arduino_Compositor comp(COMP_W, COMP_H, &out);
+  comp.begin();
+  comp.setBackground(0x001F);
+  for (int i = 0; i < layers; i++)
+  {
+    int32_t len = (int32_t)specs[i].w * specs[i].h;
+    pixels[i] = (uint16_t *)malloc(len * 2);
+    alpha[i] = specs[i].has_alpha ? (uint8_t *)malloc(len) : nullptr;
+    randomize(pixels[i], alpha[i], len);
+    comp.addLayer(pixels[i], alpha[i], specs[i].w, specs[i].h, rnd(-30, COMP_W), rnd(-30, COMP_H));
+  }
+  comp.flush();
+
+  static uint16_t incremental[COMP_H][COMP_W];
+  int result = 0;
+  for (int step = 0; (step < 2000) && !result; step++)
+  {
+    int changes = rnd(1, 12); // past GFX_COMPOSITOR_DIRTY_RECTS at times
+    for (int c = 0; c < changes; c++)
+    {
+      int8_t l = rnd(0, layers - 1);
+      switch (rnd(0, 5))
+      {
+      case 0:
+      case 1:
+        comp.moveLayer(l, rnd(-50, COMP_W + 10), rnd(-50, COMP_H + 10));
+        break;
+      case 2:
+        comp.setLayerOpacity(l, (rnd(0, 2) == 0) ? 255 : rnd(0, 255));
+        break;
+      case 3:
+        comp.setLayerVisible(l, rnd(0, 3) != 0);
+        break;
+      case 4:
+      {
+        // redraw part of a layer
+        int16_t x = rnd(0, specs[l].w - 1), y = rnd(0, specs[l].h - 1);
+        int16_t w = rnd(1, specs[l].w - x), h = rnd(1, specs[l].h - y);
+        for (int16_t j = y; j < y + h; j++)
+        {
+          randomize(pixels[l] + (j * specs[l].w) + x, alpha[l] ? (alpha[l] + (j * specs[l].w) + x) : nullptr, w);
+        }
+        comp.invalidateLayer(l, x, y, w, h);
+        break;
+      }
+      default:
+        comp.setBackground((rnd(0, 3) == 0) ? (uint16_t)rnd(0, 0xFFFF) : 0x001F);
+      }
+    }
+    comp.flush();
+
+    memcpy(incremental, out.fb, sizeof(incremental));
+    comp.invalidate(0, 0, COMP_W, COMP_H);
+    comp.flush();
+    for (int y = 0; (y < COMP_H) && !result; y++)
+    {
+      for (int x = 0; x < COMP_W; x++)
+      {
+        if (incremental[y][x] != out.fb[y][x])
+        {
+          printf("comp_test: FAIL step %d: pixel %d,%d %04x after the dirty rectangles, %04x recomposed\n",
+                 step, x, y, incremental[y][x], out.fb[y][x]);
+          result = 1;
+          break;
+        }
+      }
+    }
+    ++*steps;
+  }
+
+  for (int i = 0; i < layers; i++)
+  {
+    free(pixels[i]);
+    free(alpha[i]);
+  }
+  return result;
+}
+
+int main()
+{
+  uint32_t steps = 0;
+  if (check_blend() || check_alpha_ramp() || check_dirty_rects(&steps))
+  {
+    return 1;
+  }
+  printf("comp_test: PASS (blend exact for alpha 0 - 32, %u dirty rectangle flushes match a full recompose)\n", steps);
+  return 0;
+}
@@ -0,0 +1,288 @@
+/*******************************************************************************
+ * fillPolygon() / fillTriangleMesh() host check
+ * Every pixel the fills write is compared with a plain per pixel reference:
+ * a pixel centre is inside when an odd number of edges cross its scanline at
+ * or left of it, each edge covering the scanlines from its top vertex up to,
+ * but not including, its bottom vertex (the top-left rule).
+ *   - fixed concave, self-intersecting and clipped polygons, then random ones
+ *   - jittered grid and fan meshes: every pixel inside the mesh outline is
+ *     written exactly once, none outside, so shared edges neither overlap
+ *     nor leave gaps; the color per triangle overload colors each pixel with
+ *     the triangle the reference puts it in
+ ******************************************************************************/
+#include "Arduino_GFX.h"
+#include <vector>
+
+#define POLY_W 320
+#define POLY_H 240
+
+// Counts the writes to every pixel and keeps the last color
+class CountGFX : public Arduino_GFX
+{
+public:
+  uint8_t count[POLY_H][POLY_W];
+  uint16_t color[POLY_H][POLY_W];
+
+  CountGFX() : Arduino_GFX(POLY_W, POLY_H) { clear(); }
+  bool begin(int32_t) override { return true; }
+  void writePixelPreclipped(int16_t x, int16_t y, uint16_t c) override
+  {
+    ++count[y][x];
+    color[y][x] = c;
+  }
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t c) override
+  {
+    for (int16_t i = 0; i < w; i++)
+    {
+      if ((x + i >= 0) && (x + i < POLY_W) && (y >= 0) && (y < POLY_H))
+      {
+        writePixelPreclipped(x + i, y, c);
+      }
+    }
+  }
+  void drawBitmap(int16_t, int16_t, uint8_t *, int16_t, int16_t, uint16_t, uint16_t) override {}
+
+  void clear()
+  {
+    memset(count, 0, sizeof(count));
+    memset(color, 0, sizeof(color));
+  }
+};
+
+static CountGFX g;
+static uint32_t seed = 1;
+
+static int32_t rnd(int32_t lo, int32_t hi)
+{
+  seed = seed * 1103515245 + 12345;
+  return lo + (int32_t)((seed >> 8) % (uint32_t)(hi - lo + 1));
+}
+
+// Reference even-odd test of pixel centre (x, y), vertices visited through indices when given
+static bool ref_inside(const int16_t *points, const uint16_t *indices, uint16_t n, int32_t x, int32_t y)
+{
+  bool inside = false;
+  for (uint16_t i = 0; i < n; i++)
+  {
+    uint16_t ia = indices ? indices[i] : i;
+    uint16_t ib = indices ? indices[(i + 1) % n] : ((i + 1) % n);
+    int64_t xa = points[ia * 2], ya = points[ia * 2 + 1];
+    int64_t xb = points[ib * 2], yb = points[ib * 2 + 1];
+    if (ya > yb)
+    {
+      std::swap(xa, xb);
+      std::swap(ya, yb);
+    }
+    if ((y < ya) || (y >= yb))
+    {
+      continue;
+    }
+    // crossing at xa + (xb - xa) * (y - ya) / (yb - ya), at or left of x
+    if ((xa * (yb - ya)) + ((xb - xa) * (y - ya)) <= (x * (yb - ya)))
+    {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+static int check_polygon(const char *name, const int16_t *points, uint16_t n)
+{
+  g.clear();
+  g.fillPolygon(points, n, 1);
+  for (int32_t y = 0; y < POLY_H; y++)
+  {
+    for (int32_t x = 0; x < POLY_W; x++)
+    {
+      int expect = ref_inside(points, NULL, n, x, y) ? 1 : 0;
+      if (g.count[y][x] != expect)
+      {
+        printf("poly_test: FAIL %s (%d vertices): pixel %d,%d written %d times, expected %d\n",
+               name, n, (int)x, (int)y, g.count[y][x], expect);
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+// outline: the mesh boundary as a polygon; every pixel inside it belongs to exactly one triangle
+static int check_mesh(const char *name, const int16_t *points, const std::vector<uint16_t> &indices,
+                      const int16_t *outline, uint16_t outline_n)
+{
+  uint16_t triangles = indices.size() / 3;
+  std::vector<uint16_t> colors(triangles);
+  for (uint16_t t = 0; t < triangles; t++)
+  {
+    colors[t] = (t / 3) + 1; // runs of the same color, like a mesh sorted by material
+  }
+
+  g.clear();
+  g.fillTriangleMesh(points, indices.data(), triangles, 1);
+  for (int pass = 0; pass < 2; pass++)
+  {
+    for (int32_t y = 0; y < POLY_H; y++)
+    {
+      for (int32_t x = 0; x < POLY_W; x++)
+      {
+        int expect = ref_inside(outline, NULL, outline_n, x, y) ? 1 : 0;
+        uint16_t expect_color = 0;
+        int refs = 0;
+        for (uint16_t t = 0; t < triangles; t++)
+        {
+          if (ref_inside(points, &indices[t * 3], 3, x, y))
+          {
+            ++refs;
+            expect_color = colors[t];
+          }
+        }
+        if ((g.count[y][x] != expect) || (refs != expect))
+        {
+          printf("poly_test: FAIL %s: pixel %d,%d written %d times, in %d reference triangles, expected %d\n",
+                 name, (int)x, (int)y, g.count[y][x], refs, expect);
+          return 1;
+        }
+        if (pass && expect && (g.color[y][x] != expect_color))
+        {
+          printf("poly_test: FAIL %s: pixel %d,%d color %u, expected %u\n",
+                 name, (int)x, (int)y, g.color[y][x], expect_color);
+          return 1;
+        }
+      }
+    }
+    g.clear();
+    g.fillTriangleMesh(points, indices.data(), triangles, colors.data());
+  }
+  return 0;
+}
+
+static int polygons(uint32_t *cases)
+{
+  static const int16_t l_shape[] = {20, 20, 60, 20, 60, 100, 140, 100, 140, 140, 20, 140};
+  static const int16_t chevron[] = {10, 10, 150, 80, 10, 150, 60, 80};
+  static const int16_t comb[] = {10, 200, 10, 120, 30, 120, 30, 180, 50, 180, 50, 120, 70, 120, 70, 180,
+                                 90, 180, 90, 120, 110, 120, 110, 200};
+  static const int16_t star[] = {160, 10, 200, 150, 60, 60, 260, 60, 120, 150}; // self-intersecting
+  static const int16_t clipped[] = {-50, -30, 400, 20, 250, 300, 100, 120, -80, 260};
+  static const int16_t thin[] = {0, 0, 319, 1, 0, 2, 319, 239, 1, 239};
+  if (check_polygon("l_shape", l_shape, 6) || check_polygon("chevron", chevron, 4) ||
+      check_polygon("comb", comb, 12) || check_polygon("star", star, 5) ||
+      check_polygon("clipped", clipped, 5) || check_polygon("thin", thin, 5))
+  {
+    return 1;
+  }
+  *cases += 6;
+
+  // more vertices than GFX_POLYGON_STACK_EDGES, concave
+  int16_t gear[2 * 48];
+  for (int i = 0; i < 48; i++)
+  {
+    float a = i * (2 * (float)M_PI / 48);
+    float r = (i & 1) ? 100 : 55;
+    gear[i * 2] = 160 + (int16_t)lroundf(r * cosf(a));
+    gear[i * 2 + 1] = 120 + (int16_t)lroundf(r * sinf(a));
+  }
+  if (check_polygon("gear", gear, 48))
+  {
+    return 1;
+  }
+  ++*cases;
+
+  int16_t points[2 * 40];
+  for (int i = 0; i < 300; i++)
+  {
+    uint16_t n = rnd(3, 40);
+    for (uint16_t k = 0; k < n; k++)
+    {
+      points[k * 2] = rnd(-40, POLY_W + 40);
+      points[k * 2 + 1] = rnd(-40, POLY_H + 40);
+    }
+    if (check_polygon("random", points, n))
+    {
+      return 1;
+    }
+    ++*cases;
+  }
+  return 0;
+}
+
+static int meshes(uint32_t *cases)
+{
+  // jittered grid, two triangles per cell, diagonals both ways
+  const int cols = 8, rows = 6;
+  for (int round = 0; round < 20; round++)
+  {
+    int16_t points[2 * (cols + 1) * (rows + 1)];
+    for (int j = 0; j <= rows; j++)
+    {
+      for (int i = 0; i <= cols; i++)
+      {
+        bool edge = (i == 0) || (j == 0) || (i == cols) || (j == rows);
+        int16_t *p = &points[2 * (j * (cols + 1) + i)];
+        p[0] = 10 + i * 37 + (edge ? 0 : rnd(-12, 12));
+        p[1] = 8 + j * 37 + (edge ? 0 : rnd(-12, 12));
+      }
+    }
+    std::vector<uint16_t> indices;
+    for (int j = 0; j < rows; j++)
+    {
+      for (int i = 0; i < cols; i++)
+      {
+        uint16_t a = j * (cols + 1) + i, b = a + 1, c = a + cols + 1, d = c + 1;
+        if ((i + j + round) & 1)
+        {
+          indices.insert(indices.end(), {a, b, d, a, d, c});
+        }
+        else
+        {
+          indices.insert(indices.end(), {a, b, c, b, d, c});
+        }
+      }
+    }
+    int16_t outline[] = {10, 8, (int16_t)(10 + cols * 37), 8, (int16_t)(10 + cols * 37), (int16_t)(8 + rows * 37),
+                         10, (int16_t)(8 + rows * 37)};
+    if (check_mesh("grid mesh", points, indices, outline, 4))
+    {
+      return 1;
+    }
+    ++*cases;
+  }
+
+  // fan around a shared centre vertex, the rim partly off screen
+  for (int round = 0; round < 20; round++)
+  {
+    const int spokes = 12;
+    int16_t points[2 * (spokes + 1)];
+    points[0] = rnd(140, 180); // stays inside the rim
+    points[1] = rnd(100, 140);
+    for (int k = 0; k < spokes; k++)
+    {
+      float a = k * (2 * (float)M_PI / spokes);
+      float r = rnd(60, 200);
+      points[2 + k * 2] = 160 + (int16_t)lroundf(r * cosf(a));
+      points[3 + k * 2] = 120 + (int16_t)lroundf(r * sinf(a));
+    }
+    std::vector<uint16_t> indices;
+    for (int k = 0; k < spokes; k++)
+    {
+      indices.insert(indices.end(), {0, (uint16_t)(1 + k), (uint16_t)(1 + (k + 1) % spokes)});
+    }
+    if (check_mesh("fan mesh", points, indices, points + 2, spokes))
+    {
+      return 1;
+    }
+    ++*cases;
+  }
+  return 0;
+}
+
+int main()
+{
+  uint32_t polygon_cases = 0, mesh_cases = 0;
+  if (polygons(&polygon_cases) || meshes(&mesh_cases))
+  {
+    return 1;
+  }
+  printf("poly_test: PASS (%u polygons, %u meshes match the reference)\n", polygon_cases, mesh_cases);
+  return 0;
+}
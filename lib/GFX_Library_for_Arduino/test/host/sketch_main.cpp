@@ -0,0 +1,10 @@
+// Runs an example sketch on the host: setup() once, loop() is not called.
+// The Makefile passes the sketch path as SKETCH.
+#include <Arduino_GFX_Library.h>
+#include SKETCH
+
+int main()
+{
+  setup();
+  return 0;
+}
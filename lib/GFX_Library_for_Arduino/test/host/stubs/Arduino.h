@@ -0,0 +1,154 @@
+/*******************************************************************************
+ * Minimal Arduino core for building the hardware independent parts of the
+ * library on a desktop compiler (see ../Makefile). Only what those sources and
+ * the host benchmarks use is provided.
+ ******************************************************************************/
+#ifndef _HOST_ARDUINO_H_
+#define _HOST_ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <stdarg.h>
+#include <string>
+#include <algorithm>
+#include <chrono>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define PROGMEM
+
+#define HIGH 1
+#define LOW 0
+#define OUTPUT 1
+#define INPUT 0
+#define HEX 16
+#define DEC 10
+
+inline void pinMode(int, int) {}
+inline void digitalWrite(int, int) {}
+inline void delay(unsigned long) {}
+inline void delayMicroseconds(unsigned int) {}
+inline void yield() {}
+// 32 bit like the targets, so sketches storing the time in uint32_t wrap the same way
+inline unsigned long millis()
+{
+  return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+inline unsigned long micros()
+{
+  return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+inline long random(long n) { return n > 0 ? rand() % n : 0; }
+inline long random(long a, long b) { return a + random(b - a); }
+
+using std::max;
+using std::min;
+
+class __FlashStringHelper;
+#define F(s) ((const __FlashStringHelper *)(s))
+
+class String : public std::string
+{
+public:
+  String() {}
+  String(const char *s) : std::string(s ? s : "") {}
+  String(const std::string &s) : std::string(s) {}
+  String(int v) : std::string(std::to_string(v)) {}
+  int indexOf(const char *s) const
+  {
+    size_t p = find(s);
+    return p == npos ? -1 : (int)p;
+  }
+  unsigned int length() const { return (unsigned int)size(); }
+};
+
+class Print
+{
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t) = 0;
+  virtual size_t write(const uint8_t *b, size_t n)
+  {
+    size_t r = 0;
+    while (n--)
+      r += write(*b++);
+    return r;
+  }
+
+  size_t print(const char *s)
+  {
+    size_t r = 0;
+    while (*s)
+      r += write((uint8_t)*s++);
+    return r;
+  }
+  size_t print(const String &s) { return print(s.c_str()); }
+  size_t print(const __FlashStringHelper *s) { return print((const char *)s); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(unsigned long v, int base = DEC) { return printNumber(v, base); }
+  size_t print(unsigned int v, int base = DEC) { return printNumber(v, base); }
+  size_t print(long v, int base = DEC)
+  {
+    if (v < 0)
+      return write('-') + printNumber((unsigned long)-v, base);
+    return printNumber((unsigned long)v, base);
+  }
+  size_t print(int v, int base = DEC) { return print((long)v, base); }
+  size_t print(double v, int digits = 2)
+  {
+    char b[32];
+    snprintf(b, sizeof(b), "%.*f", digits, v);
+    return print(b);
+  }
+
+  size_t println() { return write('\n'); }
+  template <typename T>
+  size_t println(T v) { return print(v) + println(); }
+  template <typename T>
+  size_t println(T v, int base) { return print(v, base) + println(); }
+
+  size_t printf(const char *fmt, ...)
+  {
+    char b[256];
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(b, sizeof(b), fmt, ap);
+    va_end(ap);
+    return n > 0 ? print(b) : 0;
+  }
+
+private:
+  size_t printNumber(unsigned long v, int base)
+  {
+    char b[34];
+    int i = 0;
+    do
+    {
+      int d = v % base;
+      b[i++] = d < 10 ? '0' + d : 'A' + d - 10;
+      v /= base;
+    } while (v);
+    size_t r = 0;
+    while (i)
+      r += write(b[--i]);
+    return r;
+  }
+};
+
+class HardwareSerial : public Print
+{
+public:
+  void begin(unsigned long) {}
+  void flush() { fflush(stdout); }
+  operator bool() { return true; }
+  size_t write(uint8_t c) override { return fwrite(&c, 1, 1, stdout); }
+  using Print::write;
+};
+static HardwareSerial Serial;
+
+#endif // _HOST_ARDUINO_H_
@@ -0,0 +1,15 @@
+/*******************************************************************************
+ * Host stand-in for <Arduino_GFX_Library.h>: only the classes that build
+ * without board support, so examples restricted to them compile unchanged.
+ ******************************************************************************/
+#ifndef _HOST_ARDUINO_GFX_LIBRARY_H_
+#define _HOST_ARDUINO_GFX_LIBRARY_H_
+
+#include "Arduino_DataBus.h"
+#include "Arduino_GFX.h"
+#include "Arduino_TFT.h"
+#include "canvas/Arduino_Canvas.h"
+#include "databus/Arduino_TraceBus.h"
+#include "display/Arduino_ILI9341.h"
+
+#endif // _HOST_ARDUINO_GFX_LIBRARY_H_
@@ -0,0 +1,11 @@
+// Host stand-in: the SPI mode constants display drivers reference
+#ifndef _HOST_SPI_H_
+#define _HOST_SPI_H_
+
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+#define MSBFIRST 1
+
+#endif // _HOST_SPI_H_